@@ -0,0 +1,52 @@
+// AuthReplyCache.cpp
+/**
+ * @file AuthReplyCache.cpp
+ * @brief Implementation of the per‑second AuthReply cache.
+ */
+
+#include "AuthReplyCache.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+const string* AuthReplyCache::find(time_t second, bool binary) {
+	if (second != this->second) {
+		return nullptr;
+	}
+	++hitCount;
+	countEvent(Counter::AuthCacheHits);
+	return binary ? &binaryReply : &textReply;
+}
+
+bool AuthReplyCache::join(time_t second, uint64_t id, bool binary) {
+	for (auto& entry : pending) {
+		if (entry.first == second) {
+			entry.second.push_back({ id, binary });
+			++hitCount;
+			countEvent(Counter::AuthCacheHits);
+			return false;
+		}
+	}
+	pending.push_back({ second, { { id, binary } } });
+	++missCount;
+	countEvent(Counter::AuthCacheMisses);
+	return true;
+}
+
+vector<AuthReplyCache::Waiter> AuthReplyCache::complete(time_t second, const string* text, const string* binary) {
+	// Replace the entry only with a newer second; late results just serve their waiters
+	if (text && binary && second > this->second) {
+		this->second = second;
+		textReply = *text;
+		binaryReply = *binary;
+	}
+	vector<Waiter> waiters;
+	for (auto it = pending.begin(); it != pending.end(); ++it) {
+		if (it->first == second) {
+			waiters = move(it->second);
+			pending.erase(it);
+			break;
+		}
+	}
+	return waiters;
+}
@@ -0,0 +1,71 @@
+// AuthReplyCache.hpp
+/**
+ * @file AuthReplyCache.hpp
+ * @brief Opt‑in cache sharing one signed AuthReply per timestamp second.
+ */
+
+#ifndef AUTH_REPLY_CACHE_HPP
+#define AUTH_REPLY_CACHE_HPP
+
+#include <cstdint>   ///< for uint64_t
+#include <ctime>     ///< for time_t
+#include <string>    ///< for std::string
+#include <utility>   ///< for std::pair
+#include <vector>    ///< for waiter lists
+
+/**
+ * @brief Signed "AuthReply:<ts>" replies keyed by their one‑second timestamp.
+ *
+ * The reply only binds time(nullptr), so every request within one second
+ * can share a single signature. The cache keeps the newest signed second in
+ * both wire encodings; requests for a second whose signature is still being
+ * computed wait for it instead of starting another one. Used only from the
+ * network thread, so an entry is replaced in a single step when the second
+ * rolls over and no locking is needed.
+ */
+class AuthReplyCache {
+public:
+	/**
+	 * @brief A session waiting for the reply of one second.
+	 */
+	struct Waiter {
+		uint64_t id;  ///< Session id
+		bool binary;  ///< Wants the binary frame instead of hex text
+	};
+
+	/**
+	 * @brief Look up the ready reply for a second (counted as a hit if found).
+	 * @return The encoded reply, or nullptr if that second is not cached.
+	 */
+	const std::string* find(time_t second, bool binary);
+
+	/**
+	 * @brief Register a session waiting for the reply of a second.
+	 * @return True if this is the first waiter: the caller must sign the
+	 *         reply and hand it to complete() (counted as a miss).
+	 */
+	bool join(time_t second, uint64_t id, bool binary);
+
+	/**
+	 * @brief Install a freshly signed second and release its waiters.
+	 * @param text   Hex text reply, or nullptr if signing failed.
+	 * @param binary Binary frame reply, or nullptr if signing failed.
+	 * @return Sessions that were waiting for this second.
+	 */
+	std::vector<Waiter> complete(time_t second, const std::string* text, const std::string* binary);
+
+	/** @brief Requests answered without a signature of their own. */
+	uint64_t hits() const { return hitCount; }
+	/** @brief Requests that had to sign a new second. */
+	uint64_t misses() const { return missCount; }
+
+private:
+	time_t second = -1;      ///< Timestamp of the cached replies
+	std::string textReply;   ///< "<plain>|signature:<hex>"
+	std::string binaryReply; ///< AuthReply frame
+	std::vector<std::pair<time_t, std::vector<Waiter>>> pending; ///< Seconds being signed
+	uint64_t hitCount = 0;
+	uint64_t missCount = 0;
+};
+
+#endif // AUTH_REPLY_CACHE_HPP
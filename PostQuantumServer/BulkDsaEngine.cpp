@@ -0,0 +1,187 @@
+// BulkDsaEngine.cpp
+/**
+ * @file BulkDsaEngine.cpp
+ * @brief Implementation of the work‑stealing bulk ML‑DSA engine.
+ */
+
+#include "BulkDsaEngine.hpp"
+
+using namespace std;
+
+/// Chunks per worker and batch: enough to even out uneven jobs by stealing,
+/// few enough that the deque locks stay cold.
+static constexpr size_t CHUNKS_PER_WORKER = 8;
+
+BulkDsaEngine::BulkDsaEngine(size_t threads) {
+	if (threads == 0) {
+		threads = thread::hardware_concurrency();
+	}
+	if (threads == 0) {
+		threads = 1;
+	}
+	queues.reserve(threads);
+	for (size_t i = 0; i < threads; ++i) {
+		queues.push_back(make_unique<Queue>());
+	}
+	workers.reserve(threads);
+	for (size_t i = 0; i < threads; ++i) {
+		workers.emplace_back(&BulkDsaEngine::workerLoop, this, i);
+	}
+}
+
+BulkDsaEngine::~BulkDsaEngine() {
+	{
+		lock_guard<mutex> lock(idleMutex);
+		stopping = true;
+	}
+	for (auto& queue : queues) {
+		lock_guard<mutex> lock(queue->mutex);
+		queue->chunks.clear();
+	}
+	idleCv.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void BulkDsaEngine::submit(span<DsaJob> jobs, Completion done) {
+	if (jobs.empty()) {
+		if (done) {
+			done(0);
+		}
+		return;
+	}
+
+	auto batch = make_shared<Batch>();
+	batch->remaining.store(jobs.size(), memory_order_relaxed);
+	batch->done = std::move(done);
+
+	const size_t threads = queues.size();
+	size_t chunkSize = jobs.size() / (threads * CHUNKS_PER_WORKER);
+	if (chunkSize == 0) {
+		chunkSize = 1;
+	}
+
+	size_t target;
+	{
+		lock_guard<mutex> lock(idleMutex);
+		target = nextQueue;
+		nextQueue = (nextQueue + 1) % threads;
+	}
+
+	// Deal the chunks round‑robin, starting at a different worker per batch
+	size_t chunks = 0;
+	for (size_t pos = 0; pos < jobs.size(); pos += chunkSize) {
+		size_t count = jobs.size() - pos < chunkSize ? jobs.size() - pos : chunkSize;
+		Queue& queue = *queues[target];
+		{
+			// Count the chunk before it becomes visible: takeChunk decrements
+			// under the same lock, so queued can never drop below zero
+			lock_guard<mutex> lock(queue.mutex);
+			queued.fetch_add(1, memory_order_release);
+			queue.chunks.push_back(Chunk{ batch, jobs.data() + pos, count });
+		}
+		target = (target + 1) % threads;
+		++chunks;
+	}
+
+	{
+		// Pairs with the predicate check in workerLoop so no wake‑up is lost
+		lock_guard<mutex> lock(idleMutex);
+	}
+	if (chunks >= threads) {
+		idleCv.notify_all();
+	}
+	else {
+		for (size_t i = 0; i < chunks; ++i) {
+			idleCv.notify_one();
+		}
+	}
+}
+
+future<size_t> BulkDsaEngine::submit(span<DsaJob> jobs) {
+	auto promise = make_shared<std::promise<size_t>>();
+	future<size_t> result = promise->get_future();
+	submit(jobs, [promise](size_t failed) { promise->set_value(failed); });
+	return result;
+}
+
+bool BulkDsaEngine::takeChunk(size_t self, Chunk& out) {
+	const size_t threads = queues.size();
+
+	// Own deque from the back (most recently dealt, still warm)...
+	{
+		Queue& own = *queues[self];
+		lock_guard<mutex> lock(own.mutex);
+		if (!own.chunks.empty()) {
+			out = std::move(own.chunks.back());
+			own.chunks.pop_back();
+			queued.fetch_sub(1, memory_order_relaxed);
+			return true;
+		}
+	}
+	// ...then steal the oldest chunk of the next busy worker
+	for (size_t i = 1; i < threads; ++i) {
+		Queue& victim = *queues[(self + i) % threads];
+		lock_guard<mutex> lock(victim.mutex);
+		if (!victim.chunks.empty()) {
+			out = std::move(victim.chunks.front());
+			victim.chunks.pop_front();
+			queued.fetch_sub(1, memory_order_relaxed);
+			stealCount.fetch_add(1, memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool BulkDsaEngine::runJob(DsaJob& job) {
+	if (job.message == nullptr && job.messageLength != 0) {
+		return false;
+	}
+	if (job.kind == DsaJob::Kind::Sign) {
+		if (job.signer == nullptr || job.signature == nullptr) {
+			return false;
+		}
+		return PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_signer(job.signature, &job.signatureLength,
+			job.message, job.messageLength, nullptr, 0, job.signer) == 0;
+	}
+	if (job.verifier == nullptr || job.signature == nullptr) {
+		return false;
+	}
+	return PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_verifier(job.signature, job.signatureLength,
+		job.message, job.messageLength, nullptr, 0, job.verifier) == 0;
+}
+
+void BulkDsaEngine::workerLoop(size_t self) {
+	while (true) {
+		Chunk chunk;
+		if (!takeChunk(self, chunk)) {
+			unique_lock<mutex> lock(idleMutex);
+			idleCv.wait(lock, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+			if (stopping) {
+				return;
+			}
+			continue;
+		}
+
+		size_t failed = 0;
+		for (size_t i = 0; i < chunk.count; ++i) {
+			DsaJob& job = chunk.first[i];
+			job.ok = runJob(job);
+			if (!job.ok) {
+				++failed;
+			}
+		}
+		jobCount.fetch_add(chunk.count, memory_order_relaxed);
+
+		Batch& batch = *chunk.batch;
+		if (failed != 0) {
+			batch.failed.fetch_add(failed, memory_order_relaxed);
+		}
+		// The worker that finishes the last chunk reports the whole batch
+		if (batch.remaining.fetch_sub(chunk.count, memory_order_acq_rel) == chunk.count && batch.done) {
+			batch.done(batch.failed.load(memory_order_relaxed));
+		}
+	}
+}
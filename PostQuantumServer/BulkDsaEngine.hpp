@@ -0,0 +1,135 @@
+// BulkDsaEngine.hpp
+/**
+ * @file BulkDsaEngine.hpp
+ * @brief Work‑stealing thread pool for bulk ML‑DSA‑44 signing and verification.
+ */
+
+#ifndef BULK_DSA_ENGINE_HPP
+#define BULK_DSA_ENGINE_HPP
+
+#include <atomic>              ///< for pending counters
+#include <condition_variable>  ///< for idle workers
+#include <cstddef>             ///< for size_t
+#include <cstdint>             ///< for uint8_t, uint64_t
+#include <deque>               ///< for per‑worker task deques
+#include <functional>          ///< for std::function
+#include <future>              ///< for std::future
+#include <memory>              ///< for std::unique_ptr, std::shared_ptr
+#include <mutex>               ///< for deque locks
+#include <span>                ///< for std::span
+#include <thread>              ///< for std::thread
+#include <vector>              ///< for worker list
+
+extern "C" {
+#include "PQClean-master/crypto_sign/ml-dsa-44/clean/api.h"   ///< ML-DSA prepared keys
+}
+
+/**
+ * @brief One signature to produce or check.
+ *
+ * The engine only writes the output fields of its own job, so results do
+ * not depend on which thread ran it or in what order.
+ */
+struct DsaJob {
+	enum class Kind { Sign, Verify };
+
+	Kind kind = Kind::Verify;
+	const uint8_t* message = nullptr;   ///< Message to sign or verify
+	size_t messageLength = 0;
+	uint8_t* signature = nullptr;       ///< Sign: output (CRYPTO_BYTES); Verify: input
+	size_t signatureLength = 0;         ///< Sign: output; Verify: input
+	const PQCLEAN_MLDSA44_CLEAN_signer* signer = nullptr;     ///< Key for Kind::Sign
+	const PQCLEAN_MLDSA44_CLEAN_verifier* verifier = nullptr; ///< Key for Kind::Verify
+	bool ok = false;                    ///< Set when the job finished successfully
+};
+
+/**
+ * @brief Runs large sets of ML‑DSA jobs on all cores.
+ *
+ * A submitted span is cut into chunks that are dealt round‑robin to the
+ * workers' deques. Each worker takes chunks from the back of its own deque
+ * and, once it runs dry, steals from the front of the others, so uneven
+ * chunks (long messages, invalid signatures that fail early) do not leave
+ * threads idle. Keys are prepared contexts (crypto_sign_signer_new /
+ * crypto_sign_verifier_new), shared read‑only by all threads.
+ *
+ * The job span and the keys must stay alive until the batch completes.
+ */
+class BulkDsaEngine {
+public:
+	/** @brief Called once per batch, on a worker thread, with the number of failed jobs. */
+	using Completion = std::function<void(size_t failed)>;
+
+	/**
+	 * @brief Start the worker threads.
+	 * @param threads Number of workers; 0 uses std::thread::hardware_concurrency().
+	 */
+	explicit BulkDsaEngine(size_t threads = 0);
+
+	/**
+	 * @brief Drop queued chunks and join all workers.
+	 *
+	 * Batches that have not completed yet never call their completion.
+	 */
+	~BulkDsaEngine();
+
+	BulkDsaEngine(const BulkDsaEngine&) = delete;
+	BulkDsaEngine& operator=(const BulkDsaEngine&) = delete;
+
+	/**
+	 * @brief Queue a batch and report through a callback.
+	 * @param jobs Jobs to run; their ok/signature fields are filled in.
+	 * @param done Invoked when every job has finished (immediately for an empty span).
+	 */
+	void submit(std::span<DsaJob> jobs, Completion done);
+
+	/**
+	 * @brief Queue a batch and report through a future.
+	 * @param jobs Jobs to run; their ok/signature fields are filled in.
+	 * @return Future holding the number of failed jobs.
+	 */
+	std::future<size_t> submit(std::span<DsaJob> jobs);
+
+	/** @brief Number of worker threads. */
+	size_t size() const { return workers.size(); }
+
+	/** @brief Jobs finished since start. */
+	uint64_t jobsRun() const { return jobCount.load(std::memory_order_relaxed); }
+
+	/** @brief Chunks a worker took from another worker's deque. */
+	uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+private:
+	struct Batch {
+		std::atomic<size_t> remaining;
+		std::atomic<size_t> failed{ 0 };
+		Completion done;
+	};
+
+	struct Chunk {
+		std::shared_ptr<Batch> batch;
+		DsaJob* first;
+		size_t count;
+	};
+
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Chunk> chunks;
+	};
+
+	void workerLoop(size_t self);
+	bool takeChunk(size_t self, Chunk& out);
+	static bool runJob(DsaJob& job);
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+	std::mutex idleMutex;
+	std::condition_variable idleCv;
+	std::atomic<size_t> queued{ 0 };   ///< Chunks sitting in any deque
+	size_t nextQueue = 0;              ///< Round‑robin start for the next batch
+	bool stopping = false;
+	std::atomic<uint64_t> jobCount{ 0 };
+	std::atomic<uint64_t> stealCount{ 0 };
+};
+
+#endif // BULK_DSA_ENGINE_HPP
@@ -0,0 +1,205 @@
+// BulkDsaEngineTest.cpp
+/**
+ * @file BulkDsaEngineTest.cpp
+ * @brief CTest for BulkDsaEngine: bulk signing and verification with tampered inputs.
+ *
+ * Signs a span of messages of assorted lengths, then verifies them with a
+ * known subset tampered (flipped signature byte, flipped message byte,
+ * truncated signature). Every job's ok flag and the batch's failed count
+ * must match the expectation and be identical for one worker and for
+ * several, submitted as one batch or as several concurrent batches, through
+ * the future and the callback. Throughput per thread count is printed for
+ * reference only; scaling depends on the host's cores and is not checked.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <vector>
+#include "BulkDsaEngine.hpp"
+
+using namespace std;
+
+static constexpr size_t JOBS = 240;
+static constexpr size_t SIG_BYTES = PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
+
+/// Deterministic message contents (splitmix64), so a failure reproduces.
+static uint64_t nextRandom(uint64_t& state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/// Inputs and expected outcome of one verification job.
+struct VerifyCase {
+	vector<uint8_t> message;
+	vector<uint8_t> signature;
+	size_t signatureLength = 0;
+	bool expectOk = true;
+};
+
+/**
+ * @brief Verify every case on an engine with the given worker count.
+ * @param batches Number of back‑to‑back batches the span is split into.
+ * @param useCallback Report through Completion instead of the future.
+ * @return false (with a message on stderr) on any mismatch.
+ */
+static bool runVerify(const vector<VerifyCase>& cases, const PQCLEAN_MLDSA44_CLEAN_verifier* verifier,
+	size_t threads, size_t batches, bool useCallback) {
+	vector<DsaJob> jobs(cases.size());
+	size_t expectFailed = 0;
+	for (size_t i = 0; i < cases.size(); ++i) {
+		DsaJob& job = jobs[i];
+		job.kind = DsaJob::Kind::Verify;
+		job.message = cases[i].message.data();
+		job.messageLength = cases[i].message.size();
+		// The engine takes a mutable pointer for signing; verification only reads it
+		job.signature = const_cast<uint8_t*>(cases[i].signature.data());
+		job.signatureLength = cases[i].signatureLength;
+		job.verifier = verifier;
+		job.ok = !cases[i].expectOk;   // must be overwritten
+		if (!cases[i].expectOk) {
+			++expectFailed;
+		}
+	}
+
+	BulkDsaEngine engine(threads);
+	auto start = chrono::steady_clock::now();
+	size_t failed = 0;
+	size_t per = (jobs.size() + batches - 1) / batches;
+	vector<future<size_t>> results;
+	for (size_t pos = 0; pos < jobs.size(); pos += per) {
+		span<DsaJob> part = span<DsaJob>(jobs).subspan(pos, min(per, jobs.size() - pos));
+		if (useCallback) {
+			auto promise = make_shared<std::promise<size_t>>();
+			results.push_back(promise->get_future());
+			engine.submit(part, [promise](size_t n) { promise->set_value(n); });
+		}
+		else {
+			results.push_back(engine.submit(part));
+		}
+	}
+	for (auto& result : results) {
+		failed += result.get();
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	bool good = true;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		if (jobs[i].ok != cases[i].expectOk) {
+			cerr << "verify, " << threads << " threads, " << batches << " batches: job " << i
+				<< " ok=" << jobs[i].ok << ", expected " << cases[i].expectOk << endl;
+			good = false;
+		}
+	}
+	if (failed != expectFailed) {
+		cerr << "verify, " << threads << " threads, " << batches << " batches: failed count "
+			<< failed << ", expected " << expectFailed << endl;
+		good = false;
+	}
+	if (engine.jobsRun() != jobs.size()) {
+		cerr << "verify, " << threads << " threads: jobsRun " << engine.jobsRun()
+			<< ", expected " << jobs.size() << endl;
+		good = false;
+	}
+	cout << threads << " threads, " << batches << " batches: " << jobs.size() / seconds
+		<< " verifications/s, " << engine.steals() << " steals" << endl;
+	return good;
+}
+
+int main() {
+	uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES];
+	uint8_t sk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES];
+	if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(pk, sk) != 0) {
+		cerr << "keypair failed" << endl;
+		return 1;
+	}
+	PQCLEAN_MLDSA44_CLEAN_signer* signer = PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_new(sk);
+	PQCLEAN_MLDSA44_CLEAN_verifier* verifier = PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_new(pk);
+	if (signer == nullptr || verifier == nullptr) {
+		cerr << "could not prepare the keys" << endl;
+		return 1;
+	}
+
+	// Messages from empty to a few KB, so chunks take uneven time
+	uint64_t state = 0x243F6A8885A308D3ULL;
+	vector<VerifyCase> cases(JOBS);
+	for (size_t i = 0; i < JOBS; ++i) {
+		cases[i].message.resize((i * 397) % 4096);
+		for (auto& byte : cases[i].message) {
+			byte = static_cast<uint8_t>(nextRandom(state));
+		}
+		cases[i].signature.assign(SIG_BYTES, 0);
+	}
+
+	bool good = true;
+
+	// Sign all messages in one batch
+	{
+		vector<DsaJob> jobs(JOBS);
+		for (size_t i = 0; i < JOBS; ++i) {
+			jobs[i].kind = DsaJob::Kind::Sign;
+			jobs[i].message = cases[i].message.data();
+			jobs[i].messageLength = cases[i].message.size();
+			jobs[i].signature = cases[i].signature.data();
+			jobs[i].signer = signer;
+		}
+		BulkDsaEngine engine(4);
+		size_t failed = engine.submit(span<DsaJob>(jobs)).get();
+		if (failed != 0) {
+			cerr << "sign: " << failed << " jobs failed" << endl;
+			good = false;
+		}
+		for (size_t i = 0; i < JOBS; ++i) {
+			cases[i].signatureLength = jobs[i].signatureLength;
+			if (!jobs[i].ok || jobs[i].signatureLength != SIG_BYTES ||
+				PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_verifier(cases[i].signature.data(), cases[i].signatureLength,
+					cases[i].message.data(), cases[i].message.size(), nullptr, 0, verifier) != 0) {
+				cerr << "sign: job " << i << " did not produce a valid signature" << endl;
+				good = false;
+			}
+		}
+
+		// An empty span completes at once with no failures
+		if (engine.submit(span<DsaJob>()).get() != 0) {
+			cerr << "empty batch reported failures" << endl;
+			good = false;
+		}
+	}
+
+	// Tamper with a known subset
+	for (size_t i = 0; i < JOBS; ++i) {
+		VerifyCase& c = cases[i];
+		if (i % 3 == 0) {
+			c.signature[(i * 131) % SIG_BYTES] ^= 0x01;
+			c.expectOk = false;
+		}
+		if (i % 5 == 1 && !c.message.empty()) {
+			c.message[(i * 17) % c.message.size()] ^= 0x80;
+			c.expectOk = false;
+		}
+		if (i % 7 == 2) {
+			c.signatureLength -= 1;
+			c.expectOk = false;
+		}
+	}
+
+	// Same outcome for any thread count and batching
+	good = runVerify(cases, verifier, 1, 1, false) && good;
+	good = runVerify(cases, verifier, 4, 1, false) && good;
+	good = runVerify(cases, verifier, 4, 5, true) && good;
+	good = runVerify(cases, verifier, 8, 3, false) && good;
+
+	PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free(signer);
+	PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free(verifier);
+	if (!good) {
+		return 1;
+	}
+	cout << JOBS << " jobs signed and verified: results match" << endl;
+	return 0;
+}
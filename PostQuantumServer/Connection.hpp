@@ -0,0 +1,55 @@
+// Connection.hpp
+/**
+ * @file Connection.hpp
+ * @brief Per‑client connection state used by the epoll event loop.
+ */
+
+#ifndef CONNECTION_HPP
+#define CONNECTION_HPP
+
+#include <cstdint>   ///< for uint32_t, uint64_t
+#include <string>    ///< for std::string
+#include "ReadBuffer.hpp"
+
+/**
+ * @brief Protocol state of a single client connection.
+ *
+ * The handshake verbs move a connection through these states:
+ *  - Idle           → KemRequest  → KemOffered
+ *  - KemOffered     → KemCipher   → KeyEstablished
+ *  - KeyEstablished → ConfidentialData → Closing
+ *
+ * AuthRequest is accepted in any state and does not change it.
+ */
+enum class ConnState {
+	Idle,           ///< Connected, no KEM exchange started
+	KemOffered,     ///< KemInit sent, waiting for KemCipher
+	KeyEstablished, ///< Shared secret derived, ready for ConfidentialData
+	Closing         ///< Flush pending output, then close
+};
+
+/**
+ * @brief Wire encoding spoken on a connection (see Protocol.hpp).
+ */
+enum class WireMode {
+	Undecided, ///< Nothing received yet
+	Text,      ///< Legacy newline‑terminated hex verbs
+	Binary     ///< Length‑prefixed binary frames
+};
+
+/**
+ * @brief Non‑blocking client socket together with its protocol state.
+ */
+struct Connection {
+	uint64_t id = 0;                   ///< Session id, also the epoll token
+	int fd = -1;                       ///< Client socket descriptor
+	ConnState state = ConnState::Idle; ///< Current protocol state
+	WireMode mode = WireMode::Undecided; ///< Text or binary, fixed by the first byte
+	ReadBuffer inBuf;                  ///< Received bytes not yet parsed into messages
+	std::string outBuf;                ///< Bytes not yet accepted by send()
+	uint32_t events = 0;               ///< epoll events currently registered
+	bool busy = false;                 ///< A crypto job is in flight; input paused
+	uint64_t acceptedNs = 0;           ///< metricsNow() at accept, for the handshake histogram
+};
+
+#endif // CONNECTION_HPP
@@ -6,45 +6,54 @@
 
 #include "Helpers.hpp"
 #include <fstream>   ///< for file streams
-#include <cctype>    ///< for toupper
+#include <cstdint>   ///< for SIZE_MAX
 
- /**
-  * @brief Convert a single hex character to its integer value.
-  * @param c Hex digit character ('0''9', 'A''F', 'a''f').
-  * @return 015 on success, or -1 if c is not a valid hex digit.
-  */
-static int fromHexChar(char c) {
-    if (c >= '0' && c <= '9') {
-        return c - '0';
-    }
-    c = static_cast<char>(toupper(c));
-    if (c >= 'A' && c <= 'F') {
-        return c - 'A' + 10;
+#if defined(__GNUC__) && defined(__x86_64__)
+#define HEX_X86 1
+#include <immintrin.h>   ///< for SSE2 / AVX2 intrinsics
+#endif
+
+/** Uppercase digit for each nibble value. */
+static const char hexDigits[] = "0123456789ABCDEF";
+
+/**
+ * @brief Nibble value of every byte value, or -1 if it is not a hex digit.
+ */
+struct HexTable {
+    int8_t value[256];
+    HexTable() {
+        for (int c = 0; c < 256; c++) {
+            value[c] = -1;
+        }
+        for (int c = '0'; c <= '9'; c++) {
+            value[c] = static_cast<int8_t>(c - '0');
+        }
+        for (int c = 'A'; c <= 'F'; c++) {
+            value[c] = static_cast<int8_t>(c - 'A' + 10);
+            value[c + ('a' - 'A')] = static_cast<int8_t>(c - 'A' + 10);
+        }
     }
-    return -1;
-}
+};
+static const HexTable hexTable;
 
-std::string bytesToHex(const uint8_t* data, size_t size) {
-    static const char hexDigits[] = "0123456789ABCDEF";
-    std::string result;
-    result.reserve(size * 2);
+/**
+ * @brief Scalar encoder; also handles the tail the vector kernels leave.
+ */
+static void encodeScalar(const uint8_t* in, size_t size, char* out) {
     for (size_t i = 0; i < size; i++) {
-        uint8_t byte = data[i];
-        result.push_back(hexDigits[byte >> 4]);
-        result.push_back(hexDigits[byte & 0x0F]);
+        out[2 * i] = hexDigits[in[i] >> 4];
+        out[2 * i + 1] = hexDigits[in[i] & 0x0F];
     }
-    return result;
 }
 
-bool hexToBytes(const std::string& hex, uint8_t* out, size_t outSize) {
-    // The hex string must be exactly 2 * outSize characters
-    if (hex.size() != outSize * 2) {
-        return false;
-    }
+/**
+ * @brief Scalar decoder with the same strict validation as the vector kernels.
+ */
+static bool decodeScalar(const char* in, size_t outSize, uint8_t* out) {
     for (size_t i = 0; i < outSize; i++) {
-        int high = fromHexChar(hex[2 * i]);
-        int low = fromHexChar(hex[2 * i + 1]);
-        if (high < 0 || low < 0) {
+        int high = hexTable.value[static_cast<uint8_t>(in[2 * i])];
+        int low = hexTable.value[static_cast<uint8_t>(in[2 * i + 1])];
+        if ((high | low) < 0) {
             return false;
         }
         out[i] = static_cast<uint8_t>((high << 4) | low);
@@ -52,6 +61,189 @@ bool hexToBytes(const std::string& hex, uint8_t* out, size_t outSize) {
     return true;
 }
 
+#ifdef HEX_X86
+/*
+ * Vector kernels. Encoding splits every byte into two nibbles, turns each
+ * nibble into '0'..'9' or 'A'..'F' (add '0', plus 7 above 9) and interleaves
+ * them. Decoding classifies every character as digit or letter (case folded
+ * with | 0x20), rejects the block if any character is neither, and merges
+ * the nibble pairs with 16-bit shifts before packing back to bytes. Signed
+ * compares are safe: bytes >= 0x80 are negative and fail both ranges.
+ */
+
+/** @brief Nibble values (0..15) to ASCII hex digits, 16 lanes. */
+static inline __m128i nibblesToAscii128(__m128i n) {
+    __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8(7));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), letter);
+}
+
+/**
+ * @brief ASCII hex digits to nibble values, 16 lanes.
+ * @param valid Cleared if any lane is not a hex digit.
+ */
+static inline __m128i asciiToNibbles128(__m128i c, bool& valid) {
+    __m128i folded = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+    __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(folded, _mm_set1_epi8('f' + 1)));
+    if (_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xFFFF) {
+        valid = false;
+    }
+    // 'A'/'a' & 0x0F == 1, so letters need +9 on top of the low nibble
+    return _mm_add_epi8(_mm_and_si128(c, _mm_set1_epi8(0x0F)),
+        _mm_and_si128(letter, _mm_set1_epi8(9)));
+}
+
+/** @brief Merge 8 (high, low) nibble pairs into 8 bytes held in 16-bit lanes. */
+static inline __m128i pairNibbles128(__m128i n) {
+    __m128i high = _mm_and_si128(n, _mm_set1_epi16(0x00FF));
+    __m128i low = _mm_srli_epi16(n, 8);
+    return _mm_or_si128(_mm_slli_epi16(high, 4), low);
+}
+
+/** @brief SSE2 encoder, 16 bytes per step. @return Bytes processed. */
+static size_t encodeSse2(const uint8_t* in, size_t size, char* out) {
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i high = nibblesToAscii128(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i low = nibblesToAscii128(_mm_and_si128(v, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+/** @brief SSE2 decoder, 16 bytes per step. @return Bytes decoded, or SIZE_MAX if invalid. */
+static size_t decodeSse2(const char* in, size_t outSize, uint8_t* out) {
+    bool valid = true;
+    size_t i = 0;
+    for (; i + 16 <= outSize; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16));
+        __m128i bytesA = pairNibbles128(asciiToNibbles128(a, valid));
+        __m128i bytesB = pairNibbles128(asciiToNibbles128(b, valid));
+        if (!valid) {
+            return SIZE_MAX;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(bytesA, bytesB));
+    }
+    return i;
+}
+
+#define HEX_AVX2 __attribute__((target("avx2")))
+
+/** @brief Nibble values (0..15) to ASCII hex digits, 32 lanes. */
+HEX_AVX2 static inline __m256i nibblesToAscii256(__m256i n) {
+    __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(n, _mm256_set1_epi8(9)), _mm256_set1_epi8(7));
+    return _mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')), letter);
+}
+
+/** @brief ASCII hex digits to nibble values, 32 lanes (see asciiToNibbles128). */
+HEX_AVX2 static inline __m256i asciiToNibbles256(__m256i c, bool& valid) {
+    __m256i folded = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(folded, _mm256_set1_epi8('a' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), folded));
+    if (_mm256_movemask_epi8(_mm256_or_si256(digit, letter)) != -1) {
+        valid = false;
+    }
+    return _mm256_add_epi8(_mm256_and_si256(c, _mm256_set1_epi8(0x0F)),
+        _mm256_and_si256(letter, _mm256_set1_epi8(9)));
+}
+
+/** @brief Merge 16 (high, low) nibble pairs into 16 bytes held in 16-bit lanes. */
+HEX_AVX2 static inline __m256i pairNibbles256(__m256i n) {
+    __m256i high = _mm256_and_si256(n, _mm256_set1_epi16(0x00FF));
+    __m256i low = _mm256_srli_epi16(n, 8);
+    return _mm256_or_si256(_mm256_slli_epi16(high, 4), low);
+}
+
+/** @brief AVX2 encoder, 32 bytes per step. @return Bytes processed. */
+HEX_AVX2 static size_t encodeAvx2(const uint8_t* in, size_t size, char* out) {
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i high = nibblesToAscii256(_mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+        __m256i low = nibblesToAscii256(_mm256_and_si256(v, mask));
+        // unpack works per 128-bit lane: lo = bytes 0-7 | 16-23, hi = 8-15 | 24-31
+        __m256i lo = _mm256_unpacklo_epi8(high, low);
+        __m256i hi = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    return i;
+}
+
+/** @brief AVX2 decoder, 32 bytes per step. @return Bytes decoded, or SIZE_MAX if invalid. */
+HEX_AVX2 static size_t decodeAvx2(const char* in, size_t outSize, uint8_t* out) {
+    bool valid = true;
+    size_t i = 0;
+    for (; i + 32 <= outSize; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32));
+        __m256i bytesA = pairNibbles256(asciiToNibbles256(a, valid));
+        __m256i bytesB = pairNibbles256(asciiToNibbles256(b, valid));
+        if (!valid) {
+            return SIZE_MAX;
+        }
+        // packus works per 128-bit lane: restore 64-bit quarter order 0, 2, 1, 3
+        __m256i packed = _mm256_packus_epi16(bytesA, bytesB);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return i;
+}
+
+/** @brief True if the CPU supports AVX2 (probed once). */
+static bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif // HEX_X86
+
+bool bytesToHex(std::span<const uint8_t> data, std::span<char> out) {
+    if (out.size() < data.size() * 2) {
+        return false;
+    }
+    size_t done = 0;
+#ifdef HEX_X86
+    done = hasAvx2() ? encodeAvx2(data.data(), data.size(), out.data())
+        : encodeSse2(data.data(), data.size(), out.data());
+#endif
+    encodeScalar(data.data() + done, data.size() - done, out.data() + 2 * done);
+    return true;
+}
+
+bool hexToBytes(std::string_view hex, std::span<uint8_t> out) {
+    // The hex string must be exactly 2 * out.size() characters
+    if (hex.size() != out.size() * 2) {
+        return false;
+    }
+    size_t done = 0;
+#ifdef HEX_X86
+    done = hasAvx2() ? decodeAvx2(hex.data(), out.size(), out.data())
+        : decodeSse2(hex.data(), out.size(), out.data());
+    if (done == SIZE_MAX) {
+        return false;
+    }
+#endif
+    return decodeScalar(hex.data() + 2 * done, out.size() - done, out.data() + done);
+}
+
+std::string bytesToHex(const uint8_t* data, size_t size) {
+    std::string result(size * 2, '\0');
+    bytesToHex(std::span<const uint8_t>(data, size), std::span<char>(result.data(), result.size()));
+    return result;
+}
+
+bool hexToBytes(const std::string& hex, uint8_t* out, size_t outSize) {
+    return hexToBytes(std::string_view(hex), std::span<uint8_t>(out, outSize));
+}
+
 bool saveKeyToFile(const std::string& filename, const uint8_t* key, size_t keySize) {
     std::ofstream ofs(filename, std::ios::out);
     if (!ofs.good()) {
@@ -72,3 +264,10 @@ bool loadKeyFromFile(const std::string& filename, uint8_t* key, size_t keySize)
     }
     return hexToBytes(hexLine, key, keySize);
 }
+
+void secureZero(void* data, size_t size) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    while (size--) {
+        *p++ = 0;
+    }
+}
@@ -8,7 +8,9 @@
 #define HELPERS_HPP
 
 #include <cstdint>   ///< for uint8_t
+#include <span>      ///< for std::span
 #include <string>    ///< for std::string
+#include <string_view> ///< for std::string_view
 
  /**
   * @brief Convert a byte array to its uppercase hexadecimal representation.
@@ -27,6 +29,26 @@ std::string bytesToHex(const uint8_t* data, size_t size);
  */
 bool hexToBytes(const std::string& hex, uint8_t* out, size_t outSize);
 
+/**
+ * @brief Encode bytes as uppercase hex into a caller‑provided buffer.
+ *
+ * Uses AVX2 or SSE2 kernels where available; no allocation, no terminator.
+ * @param data Input bytes.
+ * @param out  Output characters; must hold at least 2 * data.size().
+ * @return True on success; false if out is too small.
+ */
+bool bytesToHex(std::span<const uint8_t> data, std::span<char> out);
+
+/**
+ * @brief Decode a hex string (either case) into a caller‑provided buffer.
+ *
+ * out may start at the same address as hex to decode in place.
+ * @param hex Hex characters, exactly 2 * out.size() of them.
+ * @param out Output bytes.
+ * @return True on success; false on length mismatch or any non‑hex character.
+ */
+bool hexToBytes(std::string_view hex, std::span<uint8_t> out);
+
 /**
  * @brief Save a binary key to a file in hex‑encoded form.
  * @param filename Path to output file.
@@ -45,4 +67,11 @@ bool saveKeyToFile(const std::string& filename, const uint8_t* key, size_t keySi
  */
 bool loadKeyFromFile(const std::string& filename, uint8_t* key, size_t keySize);
 
+/**
+ * @brief Overwrite secret bytes in a way the optimizer cannot remove.
+ * @param data Pointer to the buffer to wipe.
+ * @param size Number of bytes to zero.
+ */
+void secureZero(void* data, size_t size);
+
 #endif // HELPERS_HPP
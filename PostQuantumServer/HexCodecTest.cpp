@@ -0,0 +1,129 @@
+// HexCodecTest.cpp
+/**
+ * @file HexCodecTest.cpp
+ * @brief CTest for the span hex codec in Helpers.cpp against a scalar reference.
+ *
+ * Every length from 0 to 200 bytes is encoded and decoded, so the vector
+ * blocks and every scalar tail length are covered. Decoding must accept
+ * upper and lower case, reject each invalid character at every position,
+ * reject odd or mismatched lengths and work in place.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Helpers.hpp"
+
+using namespace std;
+
+static constexpr size_t MAX_LENGTH = 200;
+
+/// Deterministic input bytes (splitmix64), so a failure reproduces.
+static uint64_t nextRandom(uint64_t& state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/// Byte‑at‑a‑time uppercase encoder.
+static string referenceHex(const vector<uint8_t>& data) {
+	static const char digits[] = "0123456789ABCDEF";
+	string out;
+	for (uint8_t byte : data) {
+		out.push_back(digits[byte >> 4]);
+		out.push_back(digits[byte & 0x0F]);
+	}
+	return out;
+}
+
+static bool fail(const char* what, size_t length, size_t position = 0) {
+	cerr << what << ": length " << length << ", position " << position << endl;
+	return false;
+}
+
+static bool checkLength(size_t length, uint64_t& state) {
+	vector<uint8_t> data(length);
+	for (auto& byte : data) {
+		byte = static_cast<uint8_t>(nextRandom(state));
+	}
+	const string want = referenceHex(data);
+
+	// Encode into an exact and an oversized buffer; the slack stays untouched
+	string hex(2 * length + 8, '#');
+	if (!bytesToHex(span<const uint8_t>(data), span<char>(hex.data(), hex.size()))) {
+		return fail("encode rejected a large enough buffer", length);
+	}
+	if (hex.compare(0, 2 * length, want) != 0 || hex.find_first_not_of('#', 2 * length) != string::npos) {
+		return fail("encode differs from the reference", length);
+	}
+	if (length > 0 && bytesToHex(span<const uint8_t>(data), span<char>(hex.data(), 2 * length - 1))) {
+		return fail("encode accepted a short buffer", length);
+	}
+
+	// Decode upper, lower and mixed case
+	string lower = want, mixed = want;
+	for (size_t i = 0; i < want.size(); ++i) {
+		if (want[i] >= 'A' && want[i] <= 'F') {
+			lower[i] = static_cast<char>(want[i] - 'A' + 'a');
+			mixed[i] = i % 2 ? lower[i] : want[i];
+		}
+	}
+	const pair<const char*, const string*> cases[] = { { "uppercase", &want }, { "lowercase", &lower }, { "mixed case", &mixed } };
+	for (const auto& [name, text] : cases) {
+		vector<uint8_t> out(length, 0x5A);
+		if (!hexToBytes(string_view(*text), span<uint8_t>(out)) || out != data) {
+			cerr << "decode of " << name << " failed: length " << length << endl;
+			return false;
+		}
+	}
+
+	// Mismatched lengths: one character too many or too few, one pair too few
+	vector<uint8_t> out(length + 1);
+	if (hexToBytes(string_view(want + "0"), span<uint8_t>(out.data(), length))) {
+		return fail("decode accepted an odd length", length);
+	}
+	if (length > 0 && hexToBytes(string_view(want.data(), 2 * length - 1), span<uint8_t>(out.data(), length))) {
+		return fail("decode accepted a short string", length);
+	}
+	if (hexToBytes(string_view(want), span<uint8_t>(out.data(), length + 1))) {
+		return fail("decode accepted a string for fewer bytes", length);
+	}
+
+	// Every invalid character at every position
+	static const char invalid[] = { 'g', '/', ':', '@', 'G', static_cast<char>(0x80) };
+	string bad = lower;
+	for (size_t pos = 0; pos < bad.size(); ++pos) {
+		for (char c : invalid) {
+			bad[pos] = c;
+			if (hexToBytes(string_view(bad), span<uint8_t>(out.data(), length))) {
+				return fail("decode accepted an invalid character", length, pos);
+			}
+		}
+		bad[pos] = lower[pos];
+	}
+
+	// In place: the output starts at the same address as the input
+	string buffer = lower;
+	span<uint8_t> inPlace(reinterpret_cast<uint8_t*>(buffer.data()), length);
+	if (!hexToBytes(string_view(buffer), inPlace) || !equal(data.begin(), data.end(), inPlace.begin())) {
+		return fail("in-place decode failed", length);
+	}
+	return true;
+}
+
+int main() {
+	uint64_t state = 0x243F6A8885A308D3ULL;
+	for (size_t length = 0; length <= MAX_LENGTH; ++length) {
+		if (!checkLength(length, state)) {
+			return 1;
+		}
+	}
+	cout << "lengths 0.." << MAX_LENGTH << ": encode and decode match the reference" << endl;
+	return 0;
+}
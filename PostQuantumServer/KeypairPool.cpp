@@ -0,0 +1,83 @@
+// KeypairPool.cpp
+/**
+ * @file KeypairPool.cpp
+ * @brief Implementation of the pre‑generated ML‑KEM keypair ring.
+ */
+
+#include "KeypairPool.hpp"
+#include "Helpers.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+KeypairPool::KeypairPool(size_t lowWatermark, size_t highWatermark)
+	: slots(new KemKeypair[highWatermark > 0 ? highWatermark : 1]),
+	capacity(highWatermark > 0 ? highWatermark : 1),
+	lowWatermark(lowWatermark == 0 ? 1 : (lowWatermark < capacity ? lowWatermark : capacity)) {
+	refiller = thread(&KeypairPool::refillLoop, this);
+}
+
+KeypairPool::~KeypairPool() {
+	stopping.store(true);
+	wakeSeq.fetch_add(1);
+	wakeSeq.notify_one();
+	refiller.join();
+	secureZero(slots.get(), sizeof(KemKeypair) * capacity);
+}
+
+size_t KeypairPool::available() const {
+	return static_cast<size_t>(tail.load(memory_order_acquire) - head.load(memory_order_acquire));
+}
+
+bool KeypairPool::take(KemKeypair& out) {
+	uint64_t h = head.load(memory_order_relaxed);
+	uint64_t t = tail.load(memory_order_acquire);
+	if (h == t) {
+		missCount.fetch_add(1, memory_order_relaxed);
+		countEvent(Counter::KemPoolMisses);
+		wakeSeq.fetch_add(1, memory_order_release);
+		wakeSeq.notify_one();
+		return false;
+	}
+	KemKeypair& slot = slots[h % capacity];
+	memcpy(&out, &slot, sizeof(KemKeypair));
+	secureZero(slot.sk, sizeof(slot.sk));
+	head.store(h + 1, memory_order_release);
+	hitCount.fetch_add(1, memory_order_relaxed);
+	countEvent(Counter::KemPoolHits);
+	if (t - (h + 1) < lowWatermark) {
+		wakeSeq.fetch_add(1, memory_order_release);
+		wakeSeq.notify_one();
+	}
+	return true;
+}
+
+void KeypairPool::refillLoop() {
+	while (!stopping.load()) {
+		uint32_t seq = wakeSeq.load(memory_order_acquire);
+		// Fill up to the high watermark
+		while (!stopping.load()) {
+			uint64_t t = tail.load(memory_order_relaxed);
+			if (t - head.load(memory_order_acquire) >= capacity) {
+				break;
+			}
+			KemKeypair& slot = slots[t % capacity];
+			uint64_t started = metricsNow();
+			if (PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(slot.pk, slot.sk) != 0) {
+				logWrite(LogLevel::Error, NO_SESSION, "KEM key generation failed (keypair pool).");
+				break;
+			}
+			recordDuration(Timer::KemKeygen, metricsNow() - started);
+			bytesToHex(span<const uint8_t>(slot.pk), span<char>(slot.pkHex));
+			tail.store(t + 1, memory_order_release);
+		}
+		// Sleep until a take() drops the pool below the low watermark
+		while (!stopping.load() && available() >= lowWatermark) {
+			wakeSeq.wait(seq, memory_order_acquire);
+			seq = wakeSeq.load(memory_order_acquire);
+		}
+	}
+}
@@ -0,0 +1,86 @@
+// KeypairPool.hpp
+/**
+ * @file KeypairPool.hpp
+ * @brief Background‑refilled ring of ready ML‑KEM‑512 ephemeral keypairs.
+ */
+
+#ifndef KEYPAIR_POOL_HPP
+#define KEYPAIR_POOL_HPP
+
+#include <atomic>    ///< for lock‑free ring indices and counters
+#include <cstddef>   ///< for size_t
+#include <cstdint>   ///< for uint8_t, uint64_t
+#include <memory>    ///< for std::unique_ptr
+#include <thread>    ///< for refill thread
+
+extern "C" {
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/api.h"   ///< ML-KEM sizes
+}
+
+/**
+ * @brief One ephemeral keypair with its public key already hex‑encoded.
+ */
+struct KemKeypair {
+	uint8_t pk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES];     ///< Public key
+	uint8_t sk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES];     ///< Secret key
+	char pkHex[PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES * 2]; ///< Uppercase hex of pk (not terminated)
+};
+
+/**
+ * @brief Single‑producer / single‑consumer pool of pre‑generated keypairs.
+ *
+ * A background thread keeps the ring topped up: once the number of ready
+ * keypairs falls below the low watermark it generates keys until the high
+ * watermark is reached, then sleeps again. The consumer (the network
+ * thread) takes keypairs without locking. Every keypair is handed out
+ * exactly once and its slot is wiped as it is taken.
+ */
+class KeypairPool {
+public:
+	/**
+	 * @brief Create the pool and start the refill thread.
+	 * @param lowWatermark  Refill is triggered when fewer keypairs are ready.
+	 * @param highWatermark Ring capacity; refill stops when it is full.
+	 */
+	KeypairPool(size_t lowWatermark, size_t highWatermark);
+
+	/**
+	 * @brief Stop the refill thread and wipe all unused keypairs.
+	 */
+	~KeypairPool();
+
+	KeypairPool(const KeypairPool&) = delete;
+	KeypairPool& operator=(const KeypairPool&) = delete;
+
+	/**
+	 * @brief Take one ready keypair (consumer side, single thread only).
+	 * @param out Receives the keypair; the pool's copy is wiped.
+	 * @return True on a hit; false if the pool is empty (counted as a miss).
+	 */
+	bool take(KemKeypair& out);
+
+	/** @brief Number of keypairs ready right now. */
+	size_t available() const;
+	/** @brief Number of take() calls served from the pool. */
+	uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+	/** @brief Number of take() calls that found the pool empty. */
+	uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+private:
+	void refillLoop();
+
+	std::unique_ptr<KemKeypair[]> slots;
+	size_t capacity;
+	size_t lowWatermark;
+
+	std::atomic<uint64_t> head{ 0 };   ///< Next slot to take (consumer)
+	std::atomic<uint64_t> tail{ 0 };   ///< Next slot to fill (producer)
+	std::atomic<uint32_t> wakeSeq{ 0 }; ///< Bumped to wake the refill thread
+	std::atomic<bool> stopping{ false };
+	std::atomic<uint64_t> hitCount{ 0 };
+	std::atomic<uint64_t> missCount{ 0 };
+
+	std::thread refiller;
+};
+
+#endif // KEYPAIR_POOL_HPP
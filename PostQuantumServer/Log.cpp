@@ -0,0 +1,305 @@
+// Log.cpp
+/**
+ * @file Log.cpp
+ * @brief Bounded MPSC ring of fixed‑size log records and its writer thread.
+ */
+
+#include "Log.hpp"
+
+ // POSIX headers
+#include <pthread.h>  ///< for pthread_sigmask()
+#include <unistd.h>   ///< for write()
+#include <cerrno>
+#include <csignal>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>    ///< for atexit()
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Metrics.hpp"
+
+using namespace std;
+
+namespace {
+
+/** Message bytes per record; a slot is 512 bytes in total. */
+constexpr size_t TEXT_BYTES = 512 - 3 * sizeof(uint64_t) - 2 * sizeof(uint16_t);
+/** Most records formatted per write() pair. */
+constexpr size_t WRITE_BATCH = 1024;
+/** An idle writer re‑checks the ring this often even without a wake‑up. */
+constexpr chrono::milliseconds IDLE_POLL(50);
+
+/**
+ * @brief One queued record; seq implements the ring's per‑slot handshake.
+ */
+struct LogSlot {
+	atomic<uint64_t> seq;   ///< == position: free for it; == position + 1: published
+	uint64_t timeNs;        ///< CLOCK_REALTIME at logWrite()
+	uint64_t session;
+	uint16_t level;
+	uint16_t length;
+	char text[TEXT_BYTES];
+};
+
+/**
+ * @brief Bounded multi‑producer / single‑consumer queue (Vyukov's design).
+ *
+ * A producer claims a position with one CAS on tail and publishes the slot
+ * by storing position + 1 into its seq; the writer frees it again by
+ * storing position + capacity. A full ring makes the producer give up
+ * instead of waiting, so logging never blocks.
+ */
+struct LogRing {
+	unique_ptr<LogSlot[]> slots;
+	size_t mask = 0;
+	alignas(64) atomic<uint64_t> tail{ 0 };      ///< Next position to claim (producers)
+	alignas(64) uint64_t head = 0;               ///< Next position to write (writer only)
+	atomic<uint64_t> written{ 0 };               ///< head, published for logFlush()
+	atomic<uint64_t> dropped{ 0 };               ///< Records lost to a full ring
+
+	LogSlot* claim(uint64_t& position) {
+		position = tail.load(memory_order_relaxed);
+		while (true) {
+			LogSlot& slot = slots[position & mask];
+			int64_t diff = static_cast<int64_t>(slot.seq.load(memory_order_acquire) - position);
+			if (diff == 0) {
+				if (tail.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+					return &slot;
+				}
+			}
+			else if (diff < 0) {
+				return nullptr;   // the writer has not freed this slot yet: full
+			}
+			else {
+				position = tail.load(memory_order_relaxed);
+			}
+		}
+	}
+
+	LogSlot* front() {
+		LogSlot& slot = slots[head & mask];
+		return slot.seq.load(memory_order_acquire) == head + 1 ? &slot : nullptr;
+	}
+
+	void pop(LogSlot& slot) {
+		slot.seq.store(head + mask + 1, memory_order_release);
+		++head;
+	}
+};
+
+LogRing ring;
+atomic<uint8_t> minLevel{ static_cast<uint8_t>(LogLevel::Info) };
+atomic<bool> running{ false };     ///< Records go through the ring
+atomic<bool> stopping{ false };
+atomic<bool> writerIdle{ false };
+mutex idleMutex;
+condition_variable idleCv;
+thread writer;
+
+const char* const LEVEL_NAMES[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+uint64_t realtimeNs() {
+	timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @brief Append "2026-01-31T12:00:00.123456Z LEVEL [session] message\n".
+ */
+void formatRecord(string& out, uint64_t timeNs, uint16_t level, uint64_t session, const char* text, size_t length) {
+	// The date part only changes once a second
+	static thread_local time_t cachedSecond = -1;
+	static thread_local char cachedDate[32];
+	time_t second = static_cast<time_t>(timeNs / 1000000000u);
+	if (second != cachedSecond) {
+		tm utc{};
+		gmtime_r(&second, &utc);
+		strftime(cachedDate, sizeof(cachedDate), "%Y-%m-%dT%H:%M:%S", &utc);
+		cachedSecond = second;
+	}
+	char prefix[96];
+	int n;
+	if (session != NO_SESSION) {
+		// Session ids are generation << 32 | slot index
+		n = snprintf(prefix, sizeof(prefix), "%s.%06uZ %s [%u.%u] ", cachedDate,
+			static_cast<unsigned>(timeNs % 1000000000u / 1000u), LEVEL_NAMES[level],
+			static_cast<unsigned>(session & 0xFFFFFFFFu), static_cast<unsigned>(session >> 32));
+	}
+	else {
+		n = snprintf(prefix, sizeof(prefix), "%s.%06uZ %s ", cachedDate,
+			static_cast<unsigned>(timeNs % 1000000000u / 1000u), LEVEL_NAMES[level]);
+	}
+	out.append(prefix, static_cast<size_t>(n));
+	out.append(text, length);
+	out.push_back('\n');
+}
+
+void writeAll(int fd, string& data) {
+	size_t done = 0;
+	while (done < data.size()) {
+		ssize_t n = write(fd, data.data() + done, data.size() - done);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) break;   // nowhere to report it; drop the batch
+		done += static_cast<size_t>(n);
+	}
+	data.clear();
+}
+
+/**
+ * @brief Format one record into text, truncating what does not fit a slot.
+ */
+uint16_t formatText(char* text, const char* format, va_list args) {
+	int n = vsnprintf(text, TEXT_BYTES, format, args);
+	if (n < 0) {
+		return 0;
+	}
+	if (static_cast<size_t>(n) >= TEXT_BYTES) {
+		text[TEXT_BYTES - 4] = text[TEXT_BYTES - 3] = text[TEXT_BYTES - 2] = '.';
+		return static_cast<uint16_t>(TEXT_BYTES - 1);
+	}
+	return static_cast<uint16_t>(n);
+}
+
+void writerLoop() {
+	string out;
+	string err;
+	out.reserve(64 * 1024);
+	err.reserve(16 * 1024);
+	while (true) {
+		// Step 1: Format a batch of published records
+		size_t count = 0;
+		for (LogSlot* slot = ring.front(); slot && count < WRITE_BATCH; slot = ring.front(), ++count) {
+			string& target = slot->level >= static_cast<uint16_t>(LogLevel::Warning) ? err : out;
+			formatRecord(target, slot->timeNs, slot->level, slot->session, slot->text, slot->length);
+			ring.pop(*slot);
+		}
+		uint64_t lost = ring.dropped.exchange(0, memory_order_relaxed);
+		if (lost > 0) {
+			char text[96];
+			int n = snprintf(text, sizeof(text), "%llu log records dropped: ring full.",
+				static_cast<unsigned long long>(lost));
+			formatRecord(err, realtimeNs(), static_cast<uint16_t>(LogLevel::Warning), NO_SESSION, text, static_cast<size_t>(n));
+			countEvent(Counter::LogRecordsDropped, lost);
+		}
+
+		// Step 2: One write() per stream for the whole batch
+		writeAll(STDOUT_FILENO, out);
+		writeAll(STDERR_FILENO, err);
+		ring.written.store(ring.head, memory_order_release);
+		if (count > 0) {
+			continue;
+		}
+
+		// Step 3: Nothing queued: stop, or sleep until a producer wakes us
+		if (stopping.load(memory_order_acquire)) {
+			return;
+		}
+		writerIdle.store(true, memory_order_seq_cst);
+		if (!ring.front()) {
+			unique_lock<mutex> lock(idleMutex);
+			idleCv.wait_for(lock, IDLE_POLL);
+		}
+		writerIdle.store(false, memory_order_relaxed);
+	}
+}
+
+} // namespace
+
+void logStart(LogLevel level, size_t capacity) {
+	if (running.load()) {
+		return;
+	}
+	size_t size = 1;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	ring.slots.reset(new LogSlot[size]);
+	for (size_t i = 0; i < size; ++i) {
+		ring.slots[i].seq.store(i, memory_order_relaxed);
+	}
+	ring.mask = size - 1;
+	ring.tail.store(0, memory_order_relaxed);
+	ring.head = 0;
+	ring.written.store(0, memory_order_relaxed);
+	minLevel.store(static_cast<uint8_t>(level), memory_order_relaxed);
+	stopping.store(false);
+	// The writer never takes signals: the server receives them through a signalfd
+	// in its own thread, which only works while every thread keeps them blocked
+	sigset_t all;
+	sigset_t previous;
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, &previous);
+	writer = thread(writerLoop);
+	pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+	running.store(true, memory_order_release);
+
+	static bool registered = false;
+	if (!registered) {
+		atexit(logStop);
+		registered = true;
+	}
+}
+
+void logStop() {
+	if (!running.exchange(false)) {
+		return;
+	}
+	stopping.store(true, memory_order_release);
+	idleCv.notify_one();
+	writer.join();
+}
+
+void logFlush() {
+	if (!running.load(memory_order_acquire)) {
+		return;
+	}
+	uint64_t target = ring.tail.load(memory_order_acquire);
+	while (ring.written.load(memory_order_acquire) < target) {
+		idleCv.notify_one();
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+}
+
+void logWrite(LogLevel level, uint64_t session, const char* format, ...) {
+	if (static_cast<uint8_t>(level) < minLevel.load(memory_order_relaxed)) {
+		return;
+	}
+	va_list args;
+	va_start(args, format);
+	if (!running.load(memory_order_acquire)) {
+		// No writer thread (before logStart / after logStop): write in place
+		char text[TEXT_BYTES];
+		uint16_t length = formatText(text, format, args);
+		va_end(args);
+		string line;
+		formatRecord(line, realtimeNs(), static_cast<uint16_t>(level), session, text, length);
+		writeAll(level >= LogLevel::Warning ? STDERR_FILENO : STDOUT_FILENO, line);
+		return;
+	}
+	uint64_t position;
+	LogSlot* slot = ring.claim(position);
+	if (!slot) {
+		va_end(args);
+		ring.dropped.fetch_add(1, memory_order_relaxed);
+		return;
+	}
+	slot->timeNs = realtimeNs();
+	slot->session = session;
+	slot->level = static_cast<uint16_t>(level);
+	slot->length = formatText(slot->text, format, args);
+	va_end(args);
+	slot->seq.store(position + 1, memory_order_release);
+
+	// Wake the writer only if it went to sleep; a missed wake‑up costs at most IDLE_POLL
+	if (writerIdle.load(memory_order_relaxed)) {
+		idleCv.notify_one();
+	}
+}
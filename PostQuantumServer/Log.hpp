@@ -0,0 +1,62 @@
+// Log.hpp
+/**
+ * @file Log.hpp
+ * @brief Asynchronous leveled logger: lock‑free ring buffer drained by a writer thread.
+ */
+
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include <cstddef>   ///< for size_t
+#include <cstdint>   ///< for uint64_t
+
+/**
+ * @brief Severity of a log record; records below the configured level are skipped.
+ */
+enum class LogLevel : uint8_t {
+	Debug,     ///< Per‑connection lifecycle (connected, closed)
+	Info,      ///< Protocol events and startup / shutdown summaries
+	Warning,   ///< Degraded operation, e.g. the keypair pool ran dry
+	Error      ///< A client or the server hit a failure
+};
+
+/** Session id for records that do not belong to a client. */
+const uint64_t NO_SESSION = 0;
+
+/**
+ * @brief Start the writer thread.
+ *
+ * Until then, and after logStop(), records are written synchronously, so
+ * command‑line errors before startup still appear. The writer is stopped
+ * (and the ring drained) at exit as well.
+ * @param minLevel Least severe level that is recorded.
+ * @param capacity Ring size in records, rounded up to a power of two.
+ */
+void logStart(LogLevel minLevel, size_t capacity = 8192);
+
+/**
+ * @brief Write out everything queued so far and join the writer thread.
+ */
+void logStop();
+
+/**
+ * @brief Block until every record queued before the call has been written.
+ *
+ * For output that bypasses the logger (e.g. a C library printing to
+ * stdout) and must not interleave with queued records.
+ */
+void logFlush();
+
+/**
+ * @brief Queue one record: a printf‑style message with time, level and session.
+ *
+ * Never blocks and never allocates: the message is formatted straight into
+ * a ring slot (longer text is truncated). If the ring is full the record is
+ * dropped and counted; the writer reports the number of drops. Debug and
+ * Info go to stdout, Warning and Error to stderr.
+ * @param session Session id the record is about, or NO_SESSION.
+ */
+void logWrite(LogLevel level, uint64_t session, const char* format, ...)
+	__attribute__((format(printf, 3, 4)));
+
+#endif // LOG_HPP
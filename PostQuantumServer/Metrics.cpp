@@ -0,0 +1,237 @@
+// Metrics.cpp
+/**
+ * @file Metrics.cpp
+ * @brief Per‑thread metric blocks, their lock‑free registry and the Prometheus renderer.
+ */
+
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <bit>       ///< for std::bit_width
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+size_t LatencyHistogram::bucketOf(uint64_t ns) {
+	if (ns < SUB_BUCKETS) {
+		return static_cast<size_t>(ns);
+	}
+	// Leading one at bit msb; the next SUB_BITS bits pick the sub‑bucket
+	unsigned msb = static_cast<unsigned>(bit_width(ns)) - 1;
+	size_t shift = msb - SUB_BITS;
+	size_t bucket = SUB_BUCKETS + shift * SUB_BUCKETS + ((ns >> shift) & (SUB_BUCKETS - 1));
+	return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+uint64_t LatencyHistogram::bucketEnd(size_t bucket) {
+	if (bucket < SUB_BUCKETS) {
+		return bucket + 1;
+	}
+	size_t shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+	uint64_t sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+	return (SUB_BUCKETS + sub + 1) << shift;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+	// Single writer: a relaxed load/store pair is enough and avoids a locked add
+	atomic<uint64_t>& cell = buckets[bucketOf(ns)];
+	cell.store(cell.load(memory_order_relaxed) + 1, memory_order_relaxed);
+	sumNs.store(sumNs.load(memory_order_relaxed) + ns, memory_order_relaxed);
+}
+
+void LatencyHistogram::addTo(uint64_t* totals, uint64_t& totalSumNs) const {
+	for (size_t i = 0; i < BUCKETS; ++i) {
+		totals[i] += buckets[i].load(memory_order_relaxed);
+	}
+	totalSumNs += sumNs.load(memory_order_relaxed);
+}
+
+namespace {
+
+constexpr size_t COUNTERS = static_cast<size_t>(Counter::Count);
+constexpr size_t TIMERS = static_cast<size_t>(Timer::Count);
+
+/**
+ * @brief Everything one thread records.
+ */
+struct MetricsBlock {
+	atomic<uint64_t> counters[COUNTERS] = {};
+	LatencyHistogram timers[TIMERS];
+	MetricsBlock* next = nullptr;
+};
+
+/// Every thread's block, newest first; blocks are never freed
+atomic<MetricsBlock*> blocks{ nullptr };
+
+thread_local MetricsBlock* self = nullptr;
+
+MetricsBlock& thisThread() {
+	if (self) {
+		return *self;
+	}
+	MetricsBlock* block = new MetricsBlock();
+	block->next = blocks.load(memory_order_relaxed);
+	while (!blocks.compare_exchange_weak(block->next, block, memory_order_release, memory_order_relaxed)) {
+	}
+	self = block;
+	return *block;
+}
+
+/**
+ * @brief Prometheus "le" boundaries: 1‑2‑5 steps from 10 µs to 10 s.
+ */
+struct Boundary {
+	uint64_t ns;
+	const char* label;
+};
+const Boundary BOUNDARIES[] = {
+	{ 10000, "1e-05" }, { 20000, "2e-05" }, { 50000, "5e-05" },
+	{ 100000, "0.0001" }, { 200000, "0.0002" }, { 500000, "0.0005" },
+	{ 1000000, "0.001" }, { 2000000, "0.002" }, { 5000000, "0.005" },
+	{ 10000000, "0.01" }, { 20000000, "0.02" }, { 50000000, "0.05" },
+	{ 100000000, "0.1" }, { 200000000, "0.2" }, { 500000000, "0.5" },
+	{ 1000000000, "1" }, { 2000000000, "2" }, { 5000000000, "5" },
+	{ 10000000000, "10" }
+};
+
+const char* const VERBS[] = { "KemRequest", "KemCipher", "ConfidentialData", "AuthRequest", "Ack", "unknown" };
+
+void appendLine(string& out, const char* format, ...) {
+	char line[256];
+	va_list args;
+	va_start(args, format);
+	int len = vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+	if (len > 0) {
+		out.append(line, min(static_cast<size_t>(len), sizeof(line) - 1));
+	}
+	out.push_back('\n');
+}
+
+void appendHeader(string& out, const char* name, const char* type, const char* help) {
+	appendLine(out, "# HELP %s %s", name, help);
+	appendLine(out, "# TYPE %s %s", name, type);
+}
+
+/**
+ * @brief One histogram's series. HDR buckets are summed into each "le"
+ *        boundary they end at or below, so a boundary is exact to within one
+ *        HDR bucket (at most 1/16 of its value).
+ */
+void appendHistogram(string& out, const char* name, const char* labels,
+	const uint64_t* buckets, uint64_t sumNs) {
+	const char* comma = *labels ? "," : "";
+	uint64_t cumulative = 0;
+	size_t bucket = 0;
+	for (const Boundary& boundary : BOUNDARIES) {
+		while (bucket < LatencyHistogram::BUCKETS && LatencyHistogram::bucketEnd(bucket) - 1 <= boundary.ns) {
+			cumulative += buckets[bucket++];
+		}
+		appendLine(out, "%s_bucket{%s%sle=\"%s\"} %llu", name, labels, comma, boundary.label,
+			static_cast<unsigned long long>(cumulative));
+	}
+	// The count is the bucket total, so it matches the buckets even mid‑update
+	while (bucket < LatencyHistogram::BUCKETS) {
+		cumulative += buckets[bucket++];
+	}
+	uint64_t count = cumulative;
+	appendLine(out, "%s_bucket{%s%sle=\"+Inf\"} %llu", name, labels, comma, static_cast<unsigned long long>(count));
+	if (*labels) {
+		appendLine(out, "%s_sum{%s} %.9f", name, labels, static_cast<double>(sumNs) / 1e9);
+		appendLine(out, "%s_count{%s} %llu", name, labels, static_cast<unsigned long long>(count));
+	}
+	else {
+		appendLine(out, "%s_sum %.9f", name, static_cast<double>(sumNs) / 1e9);
+		appendLine(out, "%s_count %llu", name, static_cast<unsigned long long>(count));
+	}
+}
+
+} // namespace
+
+uint64_t metricsNow() {
+	return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void countEvent(Counter counter, uint64_t n) {
+	atomic<uint64_t>& cell = thisThread().counters[static_cast<size_t>(counter)];
+	cell.store(cell.load(memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+void recordDuration(Timer timer, uint64_t ns) {
+	thisThread().timers[static_cast<size_t>(timer)].record(ns);
+}
+
+string renderMetrics() {
+	// Step 1: Sum every thread's block
+	uint64_t counters[COUNTERS] = {};
+	vector<uint64_t> buckets(TIMERS * LatencyHistogram::BUCKETS);
+	uint64_t sums[TIMERS] = {};
+	for (const MetricsBlock* block = blocks.load(memory_order_acquire); block; block = block->next) {
+		for (size_t i = 0; i < COUNTERS; ++i) {
+			counters[i] += block->counters[i].load(memory_order_relaxed);
+		}
+		for (size_t t = 0; t < TIMERS; ++t) {
+			block->timers[t].addTo(&buckets[t * LatencyHistogram::BUCKETS], sums[t]);
+		}
+	}
+	auto value = [&counters](Counter counter) {
+		return static_cast<unsigned long long>(counters[static_cast<size_t>(counter)]);
+	};
+
+	// Step 2: Format
+	string out;
+	out.reserve(8192);
+	appendHeader(out, "pq_connections_accepted_total", "counter", "Client connections accepted.");
+	appendLine(out, "pq_connections_accepted_total %llu", value(Counter::ConnectionsAccepted));
+	appendHeader(out, "pq_connections_closed_total", "counter", "Client connections closed.");
+	appendLine(out, "pq_connections_closed_total %llu", value(Counter::ConnectionsClosed));
+	// Both are counted on the network thread, so the difference is the open sessions
+	unsigned long long accepted = value(Counter::ConnectionsAccepted);
+	unsigned long long closed = value(Counter::ConnectionsClosed);
+	appendHeader(out, "pq_sessions_active", "gauge", "Client sessions currently open.");
+	appendLine(out, "pq_sessions_active %llu", accepted > closed ? accepted - closed : 0);
+	appendHeader(out, "pq_bytes_received_total", "counter", "Bytes read from client sockets.");
+	appendLine(out, "pq_bytes_received_total %llu", value(Counter::BytesReceived));
+	appendHeader(out, "pq_bytes_sent_total", "counter", "Bytes written to client sockets.");
+	appendLine(out, "pq_bytes_sent_total %llu", value(Counter::BytesSent));
+	appendHeader(out, "pq_hex_decode_failures_total", "counter", "Text payloads rejected as malformed hex.");
+	appendLine(out, "pq_hex_decode_failures_total %llu", value(Counter::HexDecodeFailures));
+
+	appendHeader(out, "pq_log_records_dropped_total", "counter", "Log records dropped because the logger ring was full.");
+	appendLine(out, "pq_log_records_dropped_total %llu", value(Counter::LogRecordsDropped));
+
+	appendHeader(out, "pq_kem_pool_hits_total", "counter", "KEM keypairs taken from the precomputed pool.");
+	appendLine(out, "pq_kem_pool_hits_total %llu", value(Counter::KemPoolHits));
+	appendHeader(out, "pq_kem_pool_misses_total", "counter", "KEM keypairs generated on demand because the pool was empty.");
+	appendLine(out, "pq_kem_pool_misses_total %llu", value(Counter::KemPoolMisses));
+	appendHeader(out, "pq_auth_cache_hits_total", "counter", "AuthRequests served by an AuthReply signed for the same second.");
+	appendLine(out, "pq_auth_cache_hits_total %llu", value(Counter::AuthCacheHits));
+	appendHeader(out, "pq_auth_cache_misses_total", "counter", "AuthRequests that needed a new AuthReply signature.");
+	appendLine(out, "pq_auth_cache_misses_total %llu", value(Counter::AuthCacheMisses));
+
+	appendHeader(out, "pq_requests_total", "counter", "Requests received per protocol verb.");
+	for (size_t i = 0; i < sizeof(VERBS) / sizeof(VERBS[0]); ++i) {
+		appendLine(out, "pq_requests_total{verb=\"%s\"} %llu", VERBS[i],
+			static_cast<unsigned long long>(counters[static_cast<size_t>(Counter::RequestKemRequest) + i]));
+	}
+
+	appendHeader(out, "pq_crypto_duration_seconds", "histogram", "Time spent in one post-quantum operation.");
+	const pair<Timer, const char*> operations[] = {
+		{ Timer::KemKeygen, "op=\"kem_keygen\"" },
+		{ Timer::KemDecaps, "op=\"kem_decaps\"" },
+		{ Timer::Sign, "op=\"sign\"" }
+	};
+	for (const auto& [timer, labels] : operations) {
+		size_t t = static_cast<size_t>(timer);
+		appendHistogram(out, "pq_crypto_duration_seconds", labels, &buckets[t * LatencyHistogram::BUCKETS], sums[t]);
+	}
+	size_t handshake = static_cast<size_t>(Timer::Handshake);
+	appendHeader(out, "pq_handshake_duration_seconds", "histogram", "Time from accept to ConfidentialData.");
+	appendHistogram(out, "pq_handshake_duration_seconds", "", &buckets[handshake * LatencyHistogram::BUCKETS], sums[handshake]);
+	return out;
+}
@@ -0,0 +1,106 @@
+// Metrics.hpp
+/**
+ * @file Metrics.hpp
+ * @brief Lock‑free per‑thread counters and latency histograms, rendered for Prometheus.
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>    ///< for relaxed counter cells
+#include <cstddef>   ///< for size_t
+#include <cstdint>   ///< for uint64_t
+#include <string>    ///< for std::string
+
+/**
+ * @brief Monotonic event counters.
+ */
+enum class Counter {
+	ConnectionsAccepted,  ///< accept() returned a client
+	ConnectionsClosed,    ///< A session was closed, for any reason
+	BytesReceived,        ///< Bytes read from client sockets
+	BytesSent,            ///< Bytes accepted by send()
+	HexDecodeFailures,    ///< Text payloads rejected as malformed hex
+	RequestKemRequest,    ///< Requests per verb, text and binary alike
+	RequestKemCipher,
+	RequestConfidentialData,
+	RequestAuthRequest,
+	RequestAck,
+	RequestUnknown,
+	LogRecordsDropped,    ///< Log records lost to a full logger ring
+	KemPoolHits,          ///< KEM keypairs served from the precomputed pool
+	KemPoolMisses,        ///< Pool empty: keypair generated on demand
+	AuthCacheHits,        ///< AuthRequests answered from or joined to a cached second
+	AuthCacheMisses,      ///< AuthRequests that started a new signature
+	Count
+};
+
+/**
+ * @brief Durations kept as latency histograms.
+ */
+enum class Timer {
+	KemKeygen,   ///< One ML‑KEM keypair (keypair pool or worker fallback)
+	KemDecaps,   ///< One decapsulation plus the AES key expansion
+	Sign,        ///< One AuthReply signature (a batch is charged its mean)
+	Handshake,   ///< accept() to ConfidentialData handled
+	Count
+};
+
+/**
+ * @brief HDR‑style histogram of nanosecond durations.
+ *
+ * Values below 16 ns get a bucket each; above that every power of two is
+ * split into 16 linear sub‑buckets, so a bucket is never wider than 1/16
+ * of its lower bound. 528 buckets cover 1 ns to about 68 s; longer values
+ * land in the last bucket. Each histogram is written by one thread only,
+ * with relaxed stores, and may be read concurrently.
+ */
+class LatencyHistogram {
+public:
+	static constexpr unsigned SUB_BITS = 4;
+	static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+	static constexpr size_t BUCKETS = SUB_BUCKETS + 32 * SUB_BUCKETS;
+
+	/** @brief Add one value (owning thread only). */
+	void record(uint64_t ns);
+
+	/** @brief Add this histogram's current bucket counts and sum into plain totals. */
+	void addTo(uint64_t* buckets, uint64_t& sumNs) const;
+
+	/** @brief Bucket a value falls into. */
+	static size_t bucketOf(uint64_t ns);
+
+	/** @brief Exclusive upper bound of a bucket in nanoseconds. */
+	static uint64_t bucketEnd(size_t bucket);
+
+private:
+	std::atomic<uint64_t> buckets[BUCKETS] = {};
+	std::atomic<uint64_t> sumNs{ 0 };
+};
+
+/**
+ * @brief Monotonic clock in nanoseconds for recordDuration().
+ */
+uint64_t metricsNow();
+
+/**
+ * @brief Add to a counter of the calling thread.
+ *
+ * Every thread owns a block of counters and histograms that only it writes,
+ * so recording needs no atomic read‑modify‑write and no lock. Blocks are
+ * linked into a global list on first use and never freed, so counts of
+ * exited threads stay in the totals.
+ */
+void countEvent(Counter counter, uint64_t n = 1);
+
+/**
+ * @brief Record a duration in the calling thread's histogram.
+ */
+void recordDuration(Timer timer, uint64_t ns);
+
+/**
+ * @brief Render all threads' metrics in the Prometheus text format (0.0.4).
+ */
+std::string renderMetrics();
+
+#endif // METRICS_HPP
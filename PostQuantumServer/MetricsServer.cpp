@@ -0,0 +1,143 @@
+// MetricsServer.cpp
+/**
+ * @file MetricsServer.cpp
+ * @brief Blocking single‑threaded HTTP/1.0 responder for the metrics endpoint.
+ */
+
+#include "MetricsServer.hpp"
+
+ // POSIX socket headers
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include <cstring>
+#include <string>
+#include "Log.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+/** Largest request head read before giving up. */
+const size_t MAX_REQUEST = 8192;
+/** A scraper must send its request and accept the reply within this time. */
+const int SCRAPE_TIMEOUT_MS = 2000;
+
+MetricsServer::MetricsServer(uint16_t port) : port(port) {
+}
+
+MetricsServer::~MetricsServer() {
+	if (server.joinable()) {
+		uint64_t one = 1;
+		ssize_t rc = write(stopFd, &one, sizeof(one));
+		(void)rc;
+		server.join();
+	}
+	if (stopFd >= 0) close(stopFd);
+	if (listenFd >= 0) close(listenFd);
+}
+
+bool MetricsServer::start() {
+	listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listenFd < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Metrics socket creation failed. Code: %d", errno);
+		return false;
+	}
+	int reuse = 1;
+	setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = INADDR_ANY;
+	addr.sin_port = htons(port);
+	if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Metrics bind failed. Code: %d", errno);
+		return false;
+	}
+	if (listen(listenFd, 16) < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Metrics listen failed. Code: %d", errno);
+		return false;
+	}
+	stopFd = eventfd(0, EFD_CLOEXEC);
+	if (stopFd < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Metrics eventfd failed. Code: %d", errno);
+		return false;
+	}
+	server = thread(&MetricsServer::serveLoop, this);
+	logWrite(LogLevel::Info, NO_SESSION, "Metrics on http://0.0.0.0:%u/metrics", static_cast<unsigned>(port));
+	return true;
+}
+
+void MetricsServer::serveLoop() {
+	pollfd fds[2] = { { listenFd, POLLIN, 0 }, { stopFd, POLLIN, 0 } };
+	while (true) {
+		if (poll(fds, 2, -1) < 0) {
+			if (errno == EINTR) continue;
+			logWrite(LogLevel::Error, NO_SESSION, "Metrics poll failed. Code: %d", errno);
+			return;
+		}
+		if (fds[1].revents) {
+			return;
+		}
+		int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (fd < 0) {
+			continue;
+		}
+		serveClient(fd);
+		close(fd);
+	}
+}
+
+void MetricsServer::serveClient(int fd) {
+	timeval timeout{ SCRAPE_TIMEOUT_MS / 1000, (SCRAPE_TIMEOUT_MS % 1000) * 1000 };
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+	// Step 1: Read the request head; the body (if any) is ignored
+	string request;
+	char chunk[1024];
+	while (request.find("\r\n\r\n") == string::npos && request.find("\n\n") == string::npos) {
+		if (request.size() > MAX_REQUEST) {
+			return;
+		}
+		ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) {
+			return;
+		}
+		request.append(chunk, static_cast<size_t>(n));
+	}
+
+	// Step 2: Only "GET /metrics" (and "GET /") has a body
+	string status;
+	string body;
+	if (request.compare(0, 4, "GET ") != 0) {
+		status = "405 Method Not Allowed";
+		body = "Only GET is supported.\n";
+	}
+	else if (request.compare(4, 9, "/metrics ") == 0 || request.compare(4, 2, "/ ") == 0) {
+		status = "200 OK";
+		body = renderMetrics();
+	}
+	else {
+		status = "404 Not Found";
+		body = "Metrics are at /metrics.\n";
+	}
+	string response = "HTTP/1.0 " + status + "\r\n"
+		"Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+		"Content-Length: " + to_string(body.size()) + "\r\n"
+		"Connection: close\r\n\r\n" + body;
+
+	// Step 3: Send everything, then close
+	size_t sent = 0;
+	while (sent < response.size()) {
+		ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) {
+			return;
+		}
+		sent += static_cast<size_t>(n);
+	}
+}
@@ -0,0 +1,49 @@
+// MetricsServer.hpp
+/**
+ * @file MetricsServer.hpp
+ * @brief Minimal HTTP endpoint that serves renderMetrics() to Prometheus scrapers.
+ */
+
+#ifndef METRICS_SERVER_HPP
+#define METRICS_SERVER_HPP
+
+#include <cstdint>   ///< for uint16_t
+#include <thread>    ///< for the serving thread
+
+/**
+ * @brief Answers "GET /metrics" on its own port and thread.
+ *
+ * Scrapes are rare and tiny, so requests are served one at a time with
+ * blocking sockets; a slow scraper is cut off after a short timeout. The
+ * epoll loop never sees these connections, so scraping cannot delay
+ * clients, and the metrics stay readable while the loop is saturated.
+ */
+class MetricsServer {
+public:
+	explicit MetricsServer(uint16_t port);
+
+	/**
+	 * @brief Stop and join the serving thread.
+	 */
+	~MetricsServer();
+
+	MetricsServer(const MetricsServer&) = delete;
+	MetricsServer& operator=(const MetricsServer&) = delete;
+
+	/**
+	 * @brief Bind the port and start serving.
+	 * @return True on success; false if the socket could not be set up (reason printed).
+	 */
+	bool start();
+
+private:
+	void serveLoop();
+	void serveClient(int fd);
+
+	uint16_t port;
+	int listenFd = -1;
+	int stopFd = -1;   ///< eventfd that wakes serveLoop() for shutdown
+	std::thread server;
+};
+
+#endif // METRICS_SERVER_HPP
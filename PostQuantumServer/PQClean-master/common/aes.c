@@ -30,6 +30,7 @@
 #include <string.h>
 
 #include "aes.h"
+#include "ctxalloc.h"
 
 static inline uint32_t br_dec32le(const unsigned char *src) {
     return (uint32_t)src[0]
@@ -559,10 +560,7 @@ static void aes_ctr(unsigned char *out, size_t outlen, const unsigned char *iv,
 void aes128_ecb_keyexp(aes128ctx *r, const unsigned char *key) {
     uint64_t skey[22];
 
-    r->sk_exp = malloc(sizeof(uint64_t) * PQC_AES128_STATESIZE);
-    if (r->sk_exp == NULL) {
-        exit(111);
-    }
+    r->sk_exp = pqclean_ctx_alloc(sizeof(uint64_t) * PQC_AES128_STATESIZE);
 
     br_aes_ct64_keysched(skey, key, 16);
     br_aes_ct64_skey_expand(r->sk_exp, skey, 10);
@@ -574,10 +572,7 @@ void aes128_ctr_keyexp(aes128ctx *r, const unsigned char *key) {
 
 void aes192_ecb_keyexp(aes192ctx *r, const unsigned char *key) {
     uint64_t skey[26];
-    r->sk_exp = malloc(sizeof(uint64_t) * PQC_AES192_STATESIZE);
-    if (r->sk_exp == NULL) {
-        exit(111);
-    }
+    r->sk_exp = pqclean_ctx_alloc(sizeof(uint64_t) * PQC_AES192_STATESIZE);
 
     br_aes_ct64_keysched(skey, key, 24);
     br_aes_ct64_skey_expand(r->sk_exp, skey, 12);
@@ -589,10 +584,7 @@ void aes192_ctr_keyexp(aes192ctx *r, const unsigned char *key) {
 
 void aes256_ecb_keyexp(aes256ctx *r, const unsigned char *key) {
     uint64_t skey[30];
-    r->sk_exp = malloc(sizeof(uint64_t) * PQC_AES256_STATESIZE);
-    if (r->sk_exp == NULL) {
-        exit(111);
-    }
+    r->sk_exp = pqclean_ctx_alloc(sizeof(uint64_t) * PQC_AES256_STATESIZE);
 
     br_aes_ct64_keysched(skey, key, 32);
     br_aes_ct64_skey_expand(r->sk_exp, skey, 14);
@@ -627,13 +619,13 @@ void aes256_ctr(unsigned char *out, size_t outlen, const unsigned char *iv, cons
 }
 
 void aes128_ctx_release(aes128ctx *r) {
-    free(r->sk_exp);
+    pqclean_ctx_free(r->sk_exp, sizeof(uint64_t) * PQC_AES128_STATESIZE);
 }
 
 void aes192_ctx_release(aes192ctx *r) {
-    free(r->sk_exp);
+    pqclean_ctx_free(r->sk_exp, sizeof(uint64_t) * PQC_AES192_STATESIZE);
 }
 
 void aes256_ctx_release(aes256ctx *r) {
-    free(r->sk_exp);
+    pqclean_ctx_free(r->sk_exp, sizeof(uint64_t) * PQC_AES256_STATESIZE);
 }
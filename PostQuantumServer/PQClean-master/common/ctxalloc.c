@@ -0,0 +1,202 @@
+#include "ctxalloc.h"
+
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define PQCLEAN_THREAD_LOCAL __declspec(thread)
+#else
+#define PQCLEAN_THREAD_LOCAL __thread
+#endif
+
+static void *default_alloc(void *opaque, size_t size) {
+    (void)opaque;
+    return malloc(size);
+}
+
+static void default_free(void *opaque, void *ptr, size_t size) {
+    (void)opaque;
+    (void)size;
+    free(ptr);
+}
+
+static pqclean_allocator current = { default_alloc, default_free, NULL };
+
+static PQCLEAN_THREAD_LOCAL pqclean_alloc_stats thread_stats;
+
+void pqclean_set_allocator(const pqclean_allocator *allocator) {
+    if (allocator == NULL) {
+        current.alloc = default_alloc;
+        current.free = default_free;
+        current.opaque = NULL;
+    } else {
+        current = *allocator;
+    }
+}
+
+void *pqclean_ctx_alloc(size_t size) {
+    void *ptr = current.alloc(current.opaque, size);
+    if (ptr == NULL) {
+        exit(111);
+    }
+    thread_stats.allocs++;
+    thread_stats.bytes += size;
+    return ptr;
+}
+
+void pqclean_ctx_free(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return;
+    }
+    thread_stats.frees++;
+    current.free(current.opaque, ptr, size);
+}
+
+void pqclean_alloc_thread_stats(pqclean_alloc_stats *stats) {
+    *stats = thread_stats;
+}
+
+/*************************************************
+ * Slab pool
+ **************************************************/
+typedef union slab_block {
+    union slab_block *next;
+    uint8_t bytes[PQCLEAN_SLAB_BLOCKBYTES];
+    uint64_t align;
+} slab_block;
+
+typedef struct slab_chunk {
+    struct slab_chunk *next;
+    slab_block blocks[PQCLEAN_SLAB_CHUNKBLOCKS];
+} slab_chunk;
+
+static struct {
+    volatile long lock;
+    slab_block *free_list;
+    slab_chunk *chunks;
+    size_t blocks;
+    size_t free_blocks;
+} slab;
+
+/* CPU hint inside the spin: frees the pipeline for the sibling hyperthread
+ * and avoids a memory-order flush when the lock is released */
+static void slab_pause(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void slab_lock(void) {
+#if defined(_MSC_VER)
+    while (_InterlockedExchange(&slab.lock, 1) != 0) {
+        while (slab.lock != 0) {
+            slab_pause();
+        }
+    }
+#else
+    while (__atomic_exchange_n(&slab.lock, 1, __ATOMIC_ACQUIRE) != 0) {
+        while (__atomic_load_n(&slab.lock, __ATOMIC_RELAXED) != 0) {
+            slab_pause();
+        }
+    }
+#endif
+}
+
+static void slab_unlock(void) {
+#if defined(_MSC_VER)
+    _InterlockedExchange(&slab.lock, 0);
+#else
+    __atomic_store_n(&slab.lock, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+static void *slab_alloc(void *opaque, size_t size) {
+    slab_block *block;
+    slab_chunk *chunk;
+    size_t i;
+    (void)opaque;
+
+    if (size > PQCLEAN_SLAB_BLOCKBYTES) {
+        return malloc(size);
+    }
+
+    slab_lock();
+    if (slab.free_list == NULL) {
+        /* Carve a new chunk without the lock held, so other threads do not
+         * spin through malloc, then splice its blocks into the free list.
+         * Two threads may both add a chunk; the spare blocks stay pooled. */
+        slab_unlock();
+        chunk = malloc(sizeof(slab_chunk));
+        if (chunk == NULL) {
+            return NULL;
+        }
+        for (i = 0; i + 1 < PQCLEAN_SLAB_CHUNKBLOCKS; i++) {
+            chunk->blocks[i].next = &chunk->blocks[i + 1];
+        }
+        slab_lock();
+        chunk->blocks[PQCLEAN_SLAB_CHUNKBLOCKS - 1].next = slab.free_list;
+        slab.free_list = &chunk->blocks[0];
+        chunk->next = slab.chunks;
+        slab.chunks = chunk;
+        slab.blocks += PQCLEAN_SLAB_CHUNKBLOCKS;
+        slab.free_blocks += PQCLEAN_SLAB_CHUNKBLOCKS;
+    }
+    block = slab.free_list;
+    slab.free_list = block->next;
+    slab.free_blocks--;
+    slab_unlock();
+    return block;
+}
+
+static void slab_free(void *opaque, void *ptr, size_t size) {
+    slab_block *block = ptr;
+    (void)opaque;
+
+    if (size > PQCLEAN_SLAB_BLOCKBYTES) {
+        free(ptr);
+        return;
+    }
+
+    slab_lock();
+    block->next = slab.free_list;
+    slab.free_list = block;
+    slab.free_blocks++;
+    slab_unlock();
+}
+
+static const pqclean_allocator slab_allocator = { slab_alloc, slab_free, NULL };
+
+const pqclean_allocator *pqclean_slab_allocator(void) {
+    return &slab_allocator;
+}
+
+void pqclean_slab_usage(size_t *blocks, size_t *free_blocks) {
+    slab_lock();
+    *blocks = slab.blocks;
+    *free_blocks = slab.free_blocks;
+    slab_unlock();
+}
+
+void pqclean_slab_release(void) {
+    slab_chunk *chunk;
+
+    slab_lock();
+    while (slab.chunks != NULL) {
+        chunk = slab.chunks;
+        slab.chunks = chunk->next;
+        free(chunk);
+    }
+    slab.free_list = NULL;
+    slab.blocks = 0;
+    slab.free_blocks = 0;
+    slab_unlock();
+}
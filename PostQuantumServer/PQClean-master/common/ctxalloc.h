@@ -0,0 +1,69 @@
+#ifndef PQCLEAN_CTXALLOC_H
+#define PQCLEAN_CTXALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Allocation hook for the heap-backed contexts in fips202.c, sha2.c and
+ * aes.c (key schedules, incremental hash states).
+ *
+ * By default contexts come from malloc/free. An application may install
+ * another allocator once at startup, before any context is created; all
+ * contexts must be released through the same allocator that created them.
+ * `free` receives the size that was passed to `alloc`.
+ */
+typedef struct {
+    void *(*alloc)(void *opaque, size_t size);
+    void (*free)(void *opaque, void *ptr, size_t size);
+    void *opaque;
+} pqclean_allocator;
+
+/* Install `allocator` (copied); NULL restores malloc/free. */
+void pqclean_set_allocator(const pqclean_allocator *allocator);
+
+/* Allocate a context of `size` bytes; exits with code 111 on failure. */
+void *pqclean_ctx_alloc(size_t size);
+/* Release a context obtained from pqclean_ctx_alloc; NULL is ignored. */
+void pqclean_ctx_free(void *ptr, size_t size);
+
+/* Context allocations made by the calling thread since it started. */
+typedef struct {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t bytes;
+} pqclean_alloc_stats;
+
+void pqclean_alloc_thread_stats(pqclean_alloc_stats *stats);
+
+/*
+ * Built-in fixed-size slab pool.
+ *
+ * Every context up to PQCLEAN_SLAB_BLOCKBYTES (the largest is the 960-byte
+ * AES-256 key schedule) takes one block from a shared free list; blocks are
+ * carved from malloc'ed chunks and recycled, never returned to the system
+ * until pqclean_slab_release(). Larger requests fall back to malloc. The
+ * free list is guarded by a spinlock, so a context may be released on a
+ * different thread than the one that created it.
+ */
+#define PQCLEAN_SLAB_BLOCKBYTES 1024
+#define PQCLEAN_SLAB_CHUNKBLOCKS 64
+
+const pqclean_allocator *pqclean_slab_allocator(void);
+
+/* Blocks carved so far and blocks currently on the free list. */
+void pqclean_slab_usage(size_t *blocks, size_t *free_blocks);
+
+/* Free every chunk. Only call once no slab context is alive any more
+   and the slab pool is no longer installed. */
+void pqclean_slab_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PQCLEAN_CTXALLOC_H */
@@ -10,7 +10,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ctxalloc.h"
 #include "fips202.h"
+#include "pqbench.h"
 
 #define NROUNDS 24
 #define ROL(a, offset) (((a) << (offset)) ^ ((a) >> (64 - (offset))))
@@ -85,6 +87,7 @@ static void KeccakF1600_StatePermute(uint64_t *state) {
     uint64_t Eka, Eke, Eki, Eko, Eku;
     uint64_t Ema, Eme, Emi, Emo, Emu;
     uint64_t Esa, Ese, Esi, Eso, Esu;
+    DBENCH_START();
 
     // copyFromState(A, state)
     Aba = state[0];
@@ -331,6 +334,7 @@ static void KeccakF1600_StatePermute(uint64_t *state) {
     state[22] = Asi;
     state[23] = Aso;
     state[24] = Asu;
+    DBENCH_STOP(*thash);
 }
 
 /*************************************************
@@ -523,10 +527,7 @@ static void keccak_inc_squeeze(uint8_t *h, size_t outlen,
 }
 
 void shake128_inc_init(shake128incctx *state) {
-    state->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     keccak_inc_init(state->ctx);
 }
 
@@ -543,22 +544,16 @@ void shake128_inc_squeeze(uint8_t *output, size_t outlen, shake128incctx *state)
 }
 
 void shake128_inc_ctx_clone(shake128incctx *dest, const shake128incctx *src) {
-    dest->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void shake128_inc_ctx_release(shake128incctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void shake256_inc_init(shake256incctx *state) {
-    state->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     keccak_inc_init(state->ctx);
 }
 
@@ -575,15 +570,12 @@ void shake256_inc_squeeze(uint8_t *output, size_t outlen, shake256incctx *state)
 }
 
 void shake256_inc_ctx_clone(shake256incctx *dest, const shake256incctx *src) {
-    dest->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void shake256_inc_ctx_release(shake256incctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 /*************************************************
@@ -598,10 +590,7 @@ void shake256_inc_ctx_release(shake256incctx *state) {
  *              - size_t inlen: length of input in bytes
  **************************************************/
 void shake128_absorb(shake128ctx *state, const uint8_t *input, size_t inlen) {
-    state->ctx = malloc(PQC_SHAKECTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKECTX_BYTES);
     keccak_absorb(state->ctx, SHAKE128_RATE, input, inlen, 0x1F);
 }
 
@@ -622,16 +611,13 @@ void shake128_squeezeblocks(uint8_t *output, size_t nblocks, shake128ctx *state)
 }
 
 void shake128_ctx_clone(shake128ctx *dest, const shake128ctx *src) {
-    dest->ctx = malloc(PQC_SHAKECTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKECTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKECTX_BYTES);
 }
 
 /** Release the allocated state. Call only once. */
 void shake128_ctx_release(shake128ctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKECTX_BYTES);
 }
 
 /*************************************************
@@ -646,10 +632,7 @@ void shake128_ctx_release(shake128ctx *state) {
  *              - size_t inlen: length of input in bytes
  **************************************************/
 void shake256_absorb(shake256ctx *state, const uint8_t *input, size_t inlen) {
-    state->ctx = malloc(PQC_SHAKECTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKECTX_BYTES);
     keccak_absorb(state->ctx, SHAKE256_RATE, input, inlen, 0x1F);
 }
 
@@ -670,16 +653,13 @@ void shake256_squeezeblocks(uint8_t *output, size_t nblocks, shake256ctx *state)
 }
 
 void shake256_ctx_clone(shake256ctx *dest, const shake256ctx *src) {
-    dest->ctx = malloc(PQC_SHAKECTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKECTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKECTX_BYTES);
 }
 
 /** Release the allocated state. Call only once. */
 void shake256_ctx_release(shake256ctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKECTX_BYTES);
 }
 
 /*************************************************
@@ -696,21 +676,20 @@ void shake128(uint8_t *output, size_t outlen,
               const uint8_t *input, size_t inlen) {
     size_t nblocks = outlen / SHAKE128_RATE;
     uint8_t t[SHAKE128_RATE];
-    shake128ctx s;
+    shake128state s;
 
-    shake128_absorb(&s, input, inlen);
-    shake128_squeezeblocks(output, nblocks, &s);
+    shake128_state_absorb(&s, input, inlen);
+    shake128_state_squeezeblocks(output, nblocks, &s);
 
     output += nblocks * SHAKE128_RATE;
     outlen -= nblocks * SHAKE128_RATE;
 
     if (outlen) {
-        shake128_squeezeblocks(t, 1, &s);
+        shake128_state_squeezeblocks(t, 1, &s);
         for (size_t i = 0; i < outlen; ++i) {
             output[i] = t[i];
         }
     }
-    shake128_ctx_release(&s);
 }
 
 /*************************************************
@@ -727,41 +706,34 @@ void shake256(uint8_t *output, size_t outlen,
               const uint8_t *input, size_t inlen) {
     size_t nblocks = outlen / SHAKE256_RATE;
     uint8_t t[SHAKE256_RATE];
-    shake256ctx s;
+    shake256state s;
 
-    shake256_absorb(&s, input, inlen);
-    shake256_squeezeblocks(output, nblocks, &s);
+    shake256_state_absorb(&s, input, inlen);
+    shake256_state_squeezeblocks(output, nblocks, &s);
 
     output += nblocks * SHAKE256_RATE;
     outlen -= nblocks * SHAKE256_RATE;
 
     if (outlen) {
-        shake256_squeezeblocks(t, 1, &s);
+        shake256_state_squeezeblocks(t, 1, &s);
         for (size_t i = 0; i < outlen; ++i) {
             output[i] = t[i];
         }
     }
-    shake256_ctx_release(&s);
 }
 
 void sha3_256_inc_init(sha3_256incctx *state) {
-    state->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     keccak_inc_init(state->ctx);
 }
 
 void sha3_256_inc_ctx_clone(sha3_256incctx *dest, const sha3_256incctx *src) {
-    dest->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void sha3_256_inc_ctx_release(sha3_256incctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void sha3_256_inc_absorb(sha3_256incctx *state, const uint8_t *input, size_t inlen) {
@@ -806,18 +778,12 @@ void sha3_256(uint8_t *output, const uint8_t *input, size_t inlen) {
 }
 
 void sha3_384_inc_init(sha3_384incctx *state) {
-    state->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     keccak_inc_init(state->ctx);
 }
 
 void sha3_384_inc_ctx_clone(sha3_384incctx *dest, const sha3_384incctx *src) {
-    dest->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
@@ -826,7 +792,7 @@ void sha3_384_inc_absorb(sha3_384incctx *state, const uint8_t *input, size_t inl
 }
 
 void sha3_384_inc_ctx_release(sha3_384incctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void sha3_384_inc_finalize(uint8_t *output, sha3_384incctx *state) {
@@ -867,18 +833,12 @@ void sha3_384(uint8_t *output, const uint8_t *input, size_t inlen) {
 }
 
 void sha3_512_inc_init(sha3_512incctx *state) {
-    state->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     keccak_inc_init(state->ctx);
 }
 
 void sha3_512_inc_ctx_clone(sha3_512incctx *dest, const sha3_512incctx *src) {
-    dest->ctx = malloc(PQC_SHAKEINCCTX_BYTES);
-    if (dest->ctx == NULL) {
-        exit(111);
-    }
+    dest->ctx = pqclean_ctx_alloc(PQC_SHAKEINCCTX_BYTES);
     memcpy(dest->ctx, src->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
@@ -887,7 +847,7 @@ void sha3_512_inc_absorb(sha3_512incctx *state, const uint8_t *input, size_t inl
 }
 
 void sha3_512_inc_ctx_release(sha3_512incctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHAKEINCCTX_BYTES);
 }
 
 void sha3_512_inc_finalize(uint8_t *output, sha3_512incctx *state) {
@@ -926,3 +886,114 @@ void sha3_512(uint8_t *output, const uint8_t *input, size_t inlen) {
         output[i] = t[i];
     }
 }
+
+/*************************************************
+ * Allocation-free API
+ *
+ * Same sponge code as above, but the lanes live in the caller's struct.
+ **************************************************/
+
+void shake128_state_absorb(shake128state *state, const uint8_t *input, size_t inlen) {
+    keccak_absorb(state->s, SHAKE128_RATE, input, inlen, 0x1F);
+}
+
+void shake128_state_squeezeblocks(uint8_t *output, size_t nblocks, shake128state *state) {
+    keccak_squeezeblocks(output, nblocks, state->s, SHAKE128_RATE);
+}
+
+void shake128_inc_state_init(shake128incstate *state) {
+    keccak_inc_init(state->s);
+}
+
+void shake128_inc_state_absorb(shake128incstate *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->s, SHAKE128_RATE, input, inlen);
+}
+
+void shake128_inc_state_finalize(shake128incstate *state) {
+    keccak_inc_finalize(state->s, SHAKE128_RATE, 0x1F);
+}
+
+void shake128_inc_state_squeeze(uint8_t *output, size_t outlen, shake128incstate *state) {
+    keccak_inc_squeeze(output, outlen, state->s, SHAKE128_RATE);
+}
+
+void shake256_state_absorb(shake256state *state, const uint8_t *input, size_t inlen) {
+    keccak_absorb(state->s, SHAKE256_RATE, input, inlen, 0x1F);
+}
+
+void shake256_state_squeezeblocks(uint8_t *output, size_t nblocks, shake256state *state) {
+    keccak_squeezeblocks(output, nblocks, state->s, SHAKE256_RATE);
+}
+
+void shake256_inc_state_init(shake256incstate *state) {
+    keccak_inc_init(state->s);
+}
+
+void shake256_inc_state_absorb(shake256incstate *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->s, SHAKE256_RATE, input, inlen);
+}
+
+void shake256_inc_state_finalize(shake256incstate *state) {
+    keccak_inc_finalize(state->s, SHAKE256_RATE, 0x1F);
+}
+
+void shake256_inc_state_squeeze(uint8_t *output, size_t outlen, shake256incstate *state) {
+    keccak_inc_squeeze(output, outlen, state->s, SHAKE256_RATE);
+}
+
+void sha3_256_inc_state_init(sha3_256incstate *state) {
+    keccak_inc_init(state->s);
+}
+
+void sha3_256_inc_state_absorb(sha3_256incstate *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->s, SHA3_256_RATE, input, inlen);
+}
+
+void sha3_256_inc_state_finalize(uint8_t *output, sha3_256incstate *state) {
+    uint8_t t[SHA3_256_RATE];
+    keccak_inc_finalize(state->s, SHA3_256_RATE, 0x06);
+
+    keccak_squeezeblocks(t, 1, state->s, SHA3_256_RATE);
+
+    for (size_t i = 0; i < 32; i++) {
+        output[i] = t[i];
+    }
+}
+
+void sha3_384_inc_state_init(sha3_384incstate *state) {
+    keccak_inc_init(state->s);
+}
+
+void sha3_384_inc_state_absorb(sha3_384incstate *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->s, SHA3_384_RATE, input, inlen);
+}
+
+void sha3_384_inc_state_finalize(uint8_t *output, sha3_384incstate *state) {
+    uint8_t t[SHA3_384_RATE];
+    keccak_inc_finalize(state->s, SHA3_384_RATE, 0x06);
+
+    keccak_squeezeblocks(t, 1, state->s, SHA3_384_RATE);
+
+    for (size_t i = 0; i < 48; i++) {
+        output[i] = t[i];
+    }
+}
+
+void sha3_512_inc_state_init(sha3_512incstate *state) {
+    keccak_inc_init(state->s);
+}
+
+void sha3_512_inc_state_absorb(sha3_512incstate *state, const uint8_t *input, size_t inlen) {
+    keccak_inc_absorb(state->s, SHA3_512_RATE, input, inlen);
+}
+
+void sha3_512_inc_state_finalize(uint8_t *output, sha3_512incstate *state) {
+    uint8_t t[SHA3_512_RATE];
+    keccak_inc_finalize(state->s, SHA3_512_RATE, 0x06);
+
+    keccak_squeezeblocks(t, 1, state->s, SHA3_512_RATE);
+
+    for (size_t i = 0; i < 64; i++) {
+        output[i] = t[i];
+    }
+}
@@ -48,6 +48,41 @@ typedef struct {
     uint64_t *ctx;
 } sha3_512incctx;
 
+/* Caller-owned contexts.
+ *
+ * The `*state` variants keep the Keccak lanes inside the struct instead of
+ * behind a heap pointer, so they can live on the stack or be embedded in
+ * another object. They need no release call and can be copied by plain
+ * assignment. Incremental states carry one extra word for the byte offset.
+ */
+typedef struct {
+    uint64_t s[26];
+} shake128incstate;
+
+typedef struct {
+    uint64_t s[25];
+} shake128state;
+
+typedef struct {
+    uint64_t s[26];
+} shake256incstate;
+
+typedef struct {
+    uint64_t s[25];
+} shake256state;
+
+typedef struct {
+    uint64_t s[26];
+} sha3_256incstate;
+
+typedef struct {
+    uint64_t s[26];
+} sha3_384incstate;
+
+typedef struct {
+    uint64_t s[26];
+} sha3_512incstate;
+
 /* Initialize the state and absorb the provided input.
  *
  * This function does not support being called multiple times
@@ -163,4 +198,35 @@ void sha3_512_inc_ctx_release(sha3_512incctx *state);
 /* One-stop SHA3-512 shop */
 void sha3_512(uint8_t *output, const uint8_t *input, size_t inlen);
 
+/* Allocation-free counterparts of the functions above, operating on
+ * caller-owned states. Semantics and output are identical. */
+void shake128_state_absorb(shake128state *state, const uint8_t *input, size_t inlen);
+void shake128_state_squeezeblocks(uint8_t *output, size_t nblocks, shake128state *state);
+
+void shake128_inc_state_init(shake128incstate *state);
+void shake128_inc_state_absorb(shake128incstate *state, const uint8_t *input, size_t inlen);
+void shake128_inc_state_finalize(shake128incstate *state);
+void shake128_inc_state_squeeze(uint8_t *output, size_t outlen, shake128incstate *state);
+
+void shake256_state_absorb(shake256state *state, const uint8_t *input, size_t inlen);
+void shake256_state_squeezeblocks(uint8_t *output, size_t nblocks, shake256state *state);
+
+void shake256_inc_state_init(shake256incstate *state);
+void shake256_inc_state_absorb(shake256incstate *state, const uint8_t *input, size_t inlen);
+void shake256_inc_state_finalize(shake256incstate *state);
+void shake256_inc_state_squeeze(uint8_t *output, size_t outlen, shake256incstate *state);
+
+void sha3_256_inc_state_init(sha3_256incstate *state);
+void sha3_256_inc_state_absorb(sha3_256incstate *state, const uint8_t *input, size_t inlen);
+/* Obtain the output; `state` is left in an unspecified but valid condition */
+void sha3_256_inc_state_finalize(uint8_t *output, sha3_256incstate *state);
+
+void sha3_384_inc_state_init(sha3_384incstate *state);
+void sha3_384_inc_state_absorb(sha3_384incstate *state, const uint8_t *input, size_t inlen);
+void sha3_384_inc_state_finalize(uint8_t *output, sha3_384incstate *state);
+
+void sha3_512_inc_state_init(sha3_512incstate *state);
+void sha3_512_inc_state_absorb(sha3_512incstate *state, const uint8_t *input, size_t inlen);
+void sha3_512_inc_state_finalize(uint8_t *output, sha3_512incstate *state);
+
 #endif
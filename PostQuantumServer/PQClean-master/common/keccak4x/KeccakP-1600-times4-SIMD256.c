@@ -85,11 +85,16 @@ static const UINT64 rho56[4] = {0x0007060504030201, 0x080F0E0D0C0B0A09, 0x101716
 
 #define SnP_laneLengthInBytes 8
 
-void KeccakP1600times4_InitializeAll(void *states) {
+/* Every function is compiled for AVX2 by a target attribute rather than
+ * -mavx2, so the rest of the build stays baseline x86-64; callers use the
+ * permutation only after a runtime CPU check. */
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 void KeccakP1600times4_InitializeAll(void *states) {
     memset(states, 0, KeccakP1600times4_statesSizeInBytes);
 }
 
-void KeccakP1600times4_AddBytes(void *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length) {
+AVX2 void KeccakP1600times4_AddBytes(void *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length) {
     unsigned int sizeLeft = length;
     unsigned int lanePosition = offset / SnP_laneLengthInBytes;
     unsigned int offsetInLane = offset % SnP_laneLengthInBytes;
@@ -124,7 +129,7 @@ void KeccakP1600times4_AddBytes(void *states, unsigned int instanceIndex, const
     }
 }
 
-void KeccakP1600times4_AddLanesAll(void *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset) {
+AVX2 void KeccakP1600times4_AddLanesAll(void *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset) {
     V256 *stateAsLanes = (V256 *)states;
     unsigned int i;
     const UINT64 *curData0 = (const UINT64 *)data;
@@ -169,7 +174,7 @@ void KeccakP1600times4_AddLanesAll(void *states, const unsigned char *data, unsi
 #undef  Xor_In4
 }
 
-void KeccakP1600times4_OverwriteBytes(void *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length) {
+AVX2 void KeccakP1600times4_OverwriteBytes(void *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length) {
     unsigned int sizeLeft = length;
     unsigned int lanePosition = offset / SnP_laneLengthInBytes;
     unsigned int offsetInLane = offset % SnP_laneLengthInBytes;
@@ -200,7 +205,7 @@ void KeccakP1600times4_OverwriteBytes(void *states, unsigned int instanceIndex,
     }
 }
 
-void KeccakP1600times4_OverwriteLanesAll(void *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset) {
+AVX2 void KeccakP1600times4_OverwriteLanesAll(void *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset) {
     V256 *stateAsLanes = (V256 *)states;
     unsigned int i;
     const UINT64 *curData0 = (const UINT64 *)data;
@@ -245,7 +250,7 @@ void KeccakP1600times4_OverwriteLanesAll(void *states, const unsigned char *data
 #undef  OverWr4
 }
 
-void KeccakP1600times4_OverwriteWithZeroes(void *states, unsigned int instanceIndex, unsigned int byteCount) {
+AVX2 void KeccakP1600times4_OverwriteWithZeroes(void *states, unsigned int instanceIndex, unsigned int byteCount) {
     unsigned int sizeLeft = byteCount;
     unsigned int lanePosition = 0;
     UINT64 *statesAsLanes = (UINT64 *)states;
@@ -261,7 +266,7 @@ void KeccakP1600times4_OverwriteWithZeroes(void *states, unsigned int instanceIn
     }
 }
 
-void KeccakP1600times4_ExtractBytes(const void *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length) {
+AVX2 void KeccakP1600times4_ExtractBytes(const void *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length) {
     unsigned int sizeLeft = length;
     unsigned int lanePosition = offset / SnP_laneLengthInBytes;
     unsigned int offsetInLane = offset % SnP_laneLengthInBytes;
@@ -291,7 +296,7 @@ void KeccakP1600times4_ExtractBytes(const void *states, unsigned int instanceInd
     }
 }
 
-void KeccakP1600times4_ExtractLanesAll(const void *states, unsigned char *data, unsigned int laneCount, unsigned int laneOffset) {
+AVX2 void KeccakP1600times4_ExtractLanesAll(const void *states, unsigned char *data, unsigned int laneCount, unsigned int laneOffset) {
     UINT64 *curData0 = (UINT64 *)data;
     UINT64 *curData1 = (UINT64 *)(data + laneOffset * 1 * SnP_laneLengthInBytes);
     UINT64 *curData2 = (UINT64 *)(data + laneOffset * 2 * SnP_laneLengthInBytes);
@@ -341,7 +346,7 @@ void KeccakP1600times4_ExtractLanesAll(const void *states, unsigned char *data,
 #undef  Extr4
 }
 
-void KeccakP1600times4_ExtractAndAddBytes(const void *states, unsigned int instanceIndex, const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length) {
+AVX2 void KeccakP1600times4_ExtractAndAddBytes(const void *states, unsigned int instanceIndex, const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length) {
     unsigned int sizeLeft = length;
     unsigned int lanePosition = offset / SnP_laneLengthInBytes;
     unsigned int offsetInLane = offset % SnP_laneLengthInBytes;
@@ -380,7 +385,7 @@ void KeccakP1600times4_ExtractAndAddBytes(const void *states, unsigned int insta
     }
 }
 
-void KeccakP1600times4_ExtractAndAddLanesAll(const void *states, const unsigned char *input, unsigned char *output, unsigned int laneCount, unsigned int laneOffset) {
+AVX2 void KeccakP1600times4_ExtractAndAddLanesAll(const void *states, const unsigned char *input, unsigned char *output, unsigned int laneCount, unsigned int laneOffset) {
     const UINT64 *curInput0 = (UINT64 *)input;
     const UINT64 *curInput1 = (UINT64 *)(input + laneOffset * 1 * SnP_laneLengthInBytes);
     const UINT64 *curInput2 = (UINT64 *)(input + laneOffset * 2 * SnP_laneLengthInBytes);
@@ -803,7 +808,7 @@ static ALIGN(KeccakP1600times4_statesAlignment) const UINT64 KeccakF1600RoundCon
 #endif
 #include "KeccakP-1600-unrolling.macros"
 
-void KeccakP1600times4_PermuteAll_24rounds(void *states) {
+AVX2 void KeccakP1600times4_PermuteAll_24rounds(void *states) {
     V256 *statesAsLanes = (V256 *)states;
     declareABCDE
     #ifndef KeccakP1600times4_fullUnrolling
@@ -815,7 +820,7 @@ void KeccakP1600times4_PermuteAll_24rounds(void *states) {
     copyToState(statesAsLanes, A)
 }
 
-void KeccakP1600times4_PermuteAll_12rounds(void *states) {
+AVX2 void KeccakP1600times4_PermuteAll_12rounds(void *states) {
     V256 *statesAsLanes = (V256 *)states;
     declareABCDE
     #ifndef KeccakP1600times4_fullUnrolling
@@ -827,7 +832,7 @@ void KeccakP1600times4_PermuteAll_12rounds(void *states) {
     copyToState(statesAsLanes, A)
 }
 
-size_t KeccakF1600times4_FastLoop_Absorb(void *states, unsigned int laneCount, unsigned int laneOffsetParallel, unsigned int laneOffsetSerial, const unsigned char *data, size_t dataByteLen) {
+AVX2 size_t KeccakF1600times4_FastLoop_Absorb(void *states, unsigned int laneCount, unsigned int laneOffsetParallel, unsigned int laneOffsetSerial, const unsigned char *data, size_t dataByteLen) {
     if (laneCount == 21) {
         #if 0
         const unsigned char *dataStart = data;
@@ -927,7 +932,7 @@ size_t KeccakF1600times4_FastLoop_Absorb(void *states, unsigned int laneCount, u
     }
 }
 
-size_t KeccakP1600times4_12rounds_FastLoop_Absorb(void *states, unsigned int laneCount, unsigned int laneOffsetParallel, unsigned int laneOffsetSerial, const unsigned char *data, size_t dataByteLen) {
+AVX2 size_t KeccakP1600times4_12rounds_FastLoop_Absorb(void *states, unsigned int laneCount, unsigned int laneOffsetParallel, unsigned int laneOffsetSerial, const unsigned char *data, size_t dataByteLen) {
     if (laneCount == 21) {
         #if 0
         const unsigned char *dataStart = data;
@@ -0,0 +1,146 @@
+/* Based on the public domain implementation in fips202.c, running four
+ * sponges at once on the KeccakP1600times4 permutation */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "KeccakP-1600-times4-SnP.h"
+#include "fips202.h"
+#include "fips202x4.h"
+#include "pqbench.h"
+
+/*************************************************
+ * Name:        keccakx4_absorb_once
+ *
+ * Description: Absorb step of four Keccak sponges: initializes all states,
+ *              absorbs one input per state and applies padding.
+ *
+ * Arguments:   - keccakx4_state *state: pointer to output states
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ *              - const uint8_t **in: four inputs
+ *              - size_t inlen: length of every input in bytes
+ *              - uint8_t p: domain-separation byte for different Keccak-derived functions
+ **************************************************/
+static void keccakx4_absorb_once(keccakx4_state *state, uint32_t r,
+                                 const uint8_t *in[4], size_t inlen, uint8_t p) {
+    size_t pos = 0;
+    unsigned int j;
+    DBENCH_START();
+
+    KeccakP1600times4_InitializeAll(state->s);
+
+    while (inlen - pos >= r) {
+        for (j = 0; j < 4; ++j) {
+            KeccakP1600times4_AddBytes(state->s, j, in[j] + pos, 0, r);
+        }
+        KeccakP1600times4_PermuteAll_24rounds(state->s);
+        pos += r;
+    }
+
+    for (j = 0; j < 4; ++j) {
+        KeccakP1600times4_AddBytes(state->s, j, in[j] + pos, 0, (unsigned int)(inlen - pos));
+        KeccakP1600times4_AddByte(state->s, j, p, (unsigned int)(inlen - pos));
+        KeccakP1600times4_AddByte(state->s, j, 0x80, r - 1);
+    }
+    DBENCH_STOP(*thash);
+}
+
+/*************************************************
+ * Name:        keccakx4_squeezeblocks
+ *
+ * Description: Squeeze step of four Keccak sponges. Squeezes full blocks of
+ *              r bytes each from every state.
+ *
+ * Arguments:   - uint8_t **out: four output buffers
+ *              - size_t nblocks: number of blocks to be squeezed per state
+ *              - uint32_t r: rate in bytes (e.g., 168 for SHAKE128)
+ *              - keccakx4_state *state: pointer to in/output states
+ **************************************************/
+static void keccakx4_squeezeblocks(uint8_t *out[4], size_t nblocks, uint32_t r,
+                                   keccakx4_state *state) {
+    size_t pos = 0;
+    unsigned int j;
+    DBENCH_START();
+
+    while (nblocks > 0) {
+        KeccakP1600times4_PermuteAll_24rounds(state->s);
+        for (j = 0; j < 4; ++j) {
+            KeccakP1600times4_ExtractBytes(state->s, j, out[j] + pos, 0, r);
+        }
+        pos += r;
+        nblocks--;
+    }
+    DBENCH_STOP(*thash);
+}
+
+/*************************************************
+ * Name:        keccakx4
+ *
+ * Description: Four complete SHAKE computations with outputs of equal length.
+ **************************************************/
+static void keccakx4(uint8_t *out[4], size_t outlen, uint32_t r,
+                     const uint8_t *in[4], size_t inlen, uint8_t p) {
+    size_t nblocks = outlen / r;
+    uint8_t t[4][SHAKE128_RATE];
+    uint8_t *tail[4] = {t[0], t[1], t[2], t[3]};
+    unsigned int j;
+    keccakx4_state state;
+
+    keccakx4_absorb_once(&state, r, in, inlen, p);
+    keccakx4_squeezeblocks(out, nblocks, r, &state);
+
+    outlen -= nblocks * r;
+    if (outlen) {
+        keccakx4_squeezeblocks(tail, 1, r, &state);
+        for (j = 0; j < 4; ++j) {
+            memcpy(out[j] + nblocks * r, t[j], outlen);
+        }
+    }
+}
+
+void shake128x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen) {
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+    keccakx4_absorb_once(state, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+void shake128x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    keccakx4_squeezeblocks(out, nblocks, SHAKE128_RATE, state);
+}
+
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen) {
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+    keccakx4_absorb_once(state, SHAKE256_RATE, in, inlen, 0x1F);
+}
+
+void shake256x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    keccakx4_squeezeblocks(out, nblocks, SHAKE256_RATE, state);
+}
+
+void shake128x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3, size_t outlen,
+                const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                size_t inlen) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+    keccakx4(out, outlen, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+void shake256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3, size_t outlen,
+                const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                size_t inlen) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+    keccakx4(out, outlen, SHAKE256_RATE, in, inlen, 0x1F);
+}
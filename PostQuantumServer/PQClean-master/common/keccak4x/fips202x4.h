@@ -0,0 +1,52 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "align.h"
+
+/* The permutation is compiled for AVX2: callers must check that the CPU
+ * supports it (e.g. with __builtin_cpu_supports("avx2")) before calling
+ * any of the functions below. */
+
+/* Four interleaved Keccak states for KeccakP1600times4 (lane i of
+ * instance j at s[4*i + j]) */
+typedef struct {
+    ALIGN(32) uint64_t s[100];
+} keccakx4_state;
+
+/* Initialize four states and absorb one input of inlen bytes into each.
+ *
+ * Every instance is an independent SHAKE128 stream; the output of
+ * instance j equals shake128 over inj.
+ */
+void shake128x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen);
+/* Squeeze nblocks full blocks out of each of the four sponges.
+ *
+ * Supports being called multiple times
+ */
+void shake128x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state);
+
+void shake256x4_absorb_once(keccakx4_state *state,
+                            const uint8_t *in0, const uint8_t *in1,
+                            const uint8_t *in2, const uint8_t *in3,
+                            size_t inlen);
+void shake256x4_squeezeblocks(uint8_t *out0, uint8_t *out1,
+                              uint8_t *out2, uint8_t *out3,
+                              size_t nblocks, keccakx4_state *state);
+
+/* Four independent SHAKE128 / SHAKE256 calls of equal lengths */
+void shake128x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3, size_t outlen,
+                const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                size_t inlen);
+void shake256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3, size_t outlen,
+                const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                size_t inlen);
+
+#endif
@@ -0,0 +1,255 @@
+#include "pqbench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const op_names[PQCLEAN_BENCH_OPS] = {
+    "sign", "verify", "encaps", "decaps", "other"
+};
+
+static const char *const stage_names[PQCLEAN_BENCH_STAGES] = {
+    "matrix", "ntt", "sample", "pack", "hash", "arith"
+};
+
+const char *pqclean_bench_op_name(pqclean_bench_op op) {
+    return (unsigned)op < PQCLEAN_BENCH_OPS ? op_names[op] : "?";
+}
+
+const char *pqclean_bench_stage_name(pqclean_bench_stage stage) {
+    return (unsigned)stage < PQCLEAN_BENCH_STAGES ? stage_names[stage] : "?";
+}
+
+void pqclean_bench_diff(pqclean_bench_report *report, const pqclean_bench_report *since) {
+    size_t i, j;
+
+    for (i = 0; i < PQCLEAN_BENCH_OPS; i++) {
+        report->ops[i] -= since->ops[i];
+        report->cycles[i] -= since->cycles[i];
+        for (j = 0; j < PQCLEAN_BENCH_STAGES; j++) {
+            report->stage[i][j] -= since->stage[i][j];
+        }
+    }
+}
+
+void pqclean_bench_print(FILE *out, const pqclean_bench_report *report) {
+    size_t i, j;
+    uint64_t staged;
+
+    for (i = 0; i < PQCLEAN_BENCH_OPS; i++) {
+        if (i != PQCLEAN_BENCH_OTHER && report->ops[i] == 0) {
+            continue;
+        }
+        staged = 0;
+        for (j = 0; j < PQCLEAN_BENCH_STAGES; j++) {
+            staged += report->stage[i][j];
+        }
+        if (i == PQCLEAN_BENCH_OTHER) {
+            /* No operation to divide by: report total cycles per stage */
+            if (staged == 0) {
+                continue;
+            }
+            fprintf(out, "%-8s cycles total\n", op_names[i]);
+            for (j = 0; j < PQCLEAN_BENCH_STAGES; j++) {
+                fprintf(out, "  %-8s %14llu\n", stage_names[j],
+                        (unsigned long long)report->stage[i][j]);
+            }
+            continue;
+        }
+        fprintf(out, "%-8s %llu ops, %.0f cycles/op\n", op_names[i],
+                (unsigned long long)report->ops[i],
+                (double)report->cycles[i] / (double)report->ops[i]);
+        for (j = 0; j < PQCLEAN_BENCH_STAGES; j++) {
+            fprintf(out, "  %-8s %12.0f %5.1f%%\n", stage_names[j],
+                    (double)report->stage[i][j] / (double)report->ops[i],
+                    report->cycles[i] ? 100.0 * (double)report->stage[i][j] / (double)report->cycles[i] : 0.0);
+        }
+        /* Unmarked code: control flow, copies, randombytes */
+        fprintf(out, "  %-8s %12.0f %5.1f%%\n", "rest",
+                (double)(report->cycles[i] > staged ? report->cycles[i] - staged : 0) / (double)report->ops[i],
+                report->cycles[i] > staged ? 100.0 * (double)(report->cycles[i] - staged) / (double)report->cycles[i] : 0.0);
+    }
+}
+
+#ifdef PQCLEAN_BENCH
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+#define PQCLEAN_THREAD_LOCAL __declspec(thread)
+#define BENCH_LOAD(x) (*(volatile const uint64_t *)&(x))
+#else
+#define PQCLEAN_THREAD_LOCAL __thread
+#define BENCH_LOAD(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#endif
+
+/* Deepest stage nesting tracked; deeper stages still count, but their
+   cycles are not subtracted from the enclosing stage */
+#define BENCH_MAX_DEPTH 16
+
+typedef struct bench_thread {
+    pqclean_bench_report report;
+    pqclean_bench_op op;                 /* operation being timed */
+    unsigned op_depth;                   /* nesting of DBENCH_OP_START */
+    uint64_t op_start;
+    unsigned depth;                      /* nesting of DBENCH_START */
+    uint64_t child[BENCH_MAX_DEPTH];     /* cycles of finished nested stages */
+    struct bench_thread *next;
+} bench_thread;
+
+/* Every thread's block, newest first; blocks are never freed so exited
+   threads stay in the totals */
+static bench_thread *bench_threads;
+
+static PQCLEAN_THREAD_LOCAL bench_thread *bench_self;
+
+/* Only the owning thread writes a block, so it needs no locks */
+static bench_thread *bench_this_thread(void) {
+    bench_thread *t = bench_self;
+
+    if (t != NULL) {
+        return t;
+    }
+    t = calloc(1, sizeof(bench_thread));
+    if (t == NULL) {
+        exit(111);
+    }
+    t->op = PQCLEAN_BENCH_OTHER;
+#if defined(_MSC_VER)
+    do {
+        t->next = *(bench_thread *volatile *)&bench_threads;
+    } while (_InterlockedCompareExchangePointer((void *volatile *)&bench_threads, t, t->next) != t->next);
+#else
+    t->next = __atomic_load_n(&bench_threads, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&bench_threads, &t->next, t, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+#endif
+    bench_self = t;
+    return t;
+}
+
+static uint64_t bench_now(void) {
+#if defined(__x86_64__) || defined(__i386__) || defined(_MSC_VER)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+int pqclean_bench_enabled(void) {
+    return 1;
+}
+
+uint64_t pqclean_bench_enter(void) {
+    bench_thread *t = bench_this_thread();
+
+    if (t->depth < BENCH_MAX_DEPTH) {
+        t->child[t->depth] = 0;
+    }
+    t->depth++;
+    return bench_now();
+}
+
+uint64_t pqclean_bench_leave(uint64_t start) {
+    uint64_t total = bench_now() - start;
+    uint64_t self = total;
+    bench_thread *t = bench_self;
+
+    t->depth--;
+    if (t->depth < BENCH_MAX_DEPTH) {
+        self -= t->child[t->depth];
+    }
+    if (t->depth > 0 && t->depth - 1 < BENCH_MAX_DEPTH) {
+        t->child[t->depth - 1] += total;
+    }
+    return self;
+}
+
+uint64_t *pqclean_bench_counter(pqclean_bench_stage stage) {
+    bench_thread *t = bench_this_thread();
+
+    return &t->report.stage[t->op][stage];
+}
+
+void pqclean_bench_op_start(pqclean_bench_op op) {
+    bench_thread *t = bench_this_thread();
+
+    if (t->op_depth++ == 0) {
+        t->op = op;
+        t->op_start = bench_now();
+    }
+}
+
+void pqclean_bench_op_stop(void) {
+    bench_thread *t = bench_self;
+
+    if (--t->op_depth == 0) {
+        t->report.cycles[t->op] += bench_now() - t->op_start;
+        t->report.ops[t->op]++;
+        t->op = PQCLEAN_BENCH_OTHER;
+    }
+}
+
+void pqclean_bench_snapshot(pqclean_bench_report *report) {
+    const bench_thread *t;
+    size_t i, j;
+
+    memset(report, 0, sizeof(*report));
+#if defined(_MSC_VER)
+    t = *(bench_thread *volatile *)&bench_threads;
+#else
+    t = __atomic_load_n(&bench_threads, __ATOMIC_ACQUIRE);
+#endif
+    for (; t != NULL; t = t->next) {
+        for (i = 0; i < PQCLEAN_BENCH_OPS; i++) {
+            report->ops[i] += BENCH_LOAD(t->report.ops[i]);
+            report->cycles[i] += BENCH_LOAD(t->report.cycles[i]);
+            for (j = 0; j < PQCLEAN_BENCH_STAGES; j++) {
+                report->stage[i][j] += BENCH_LOAD(t->report.stage[i][j]);
+            }
+        }
+    }
+}
+
+#else
+
+int pqclean_bench_enabled(void) {
+    return 0;
+}
+
+uint64_t pqclean_bench_enter(void) {
+    return 0;
+}
+
+uint64_t pqclean_bench_leave(uint64_t start) {
+    (void)start;
+    return 0;
+}
+
+uint64_t *pqclean_bench_counter(pqclean_bench_stage stage) {
+    static uint64_t sink;
+
+    (void)stage;
+    return &sink;
+}
+
+void pqclean_bench_op_start(pqclean_bench_op op) {
+    (void)op;
+}
+
+void pqclean_bench_op_stop(void) {
+}
+
+void pqclean_bench_snapshot(pqclean_bench_report *report) {
+    memset(report, 0, sizeof(*report));
+}
+
+#endif
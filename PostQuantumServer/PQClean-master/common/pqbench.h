@@ -0,0 +1,106 @@
+#ifndef PQCLEAN_PQBENCH_H
+#define PQCLEAN_PQBENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Per-stage cycle profiler behind the DBENCH_START()/DBENCH_STOP(t) markers.
+ *
+ * Only active when the library is built with PQCLEAN_BENCH defined (CMake
+ * option PQCLEAN_BENCH); otherwise the markers compile to nothing and the
+ * functions below report zeros.
+ *
+ * DBENCH_OP_START(op)/DBENCH_OP_STOP() bracket one public operation (sign,
+ * verify, encaps, decaps); nested brackets count once, as the outermost.
+ * DBENCH_START()/DBENCH_STOP(*tstage) bracket one stage inside it. Stages
+ * nest as well: each stage is charged its own ("self") cycles only, the
+ * cycles of stages nested inside it go to those, so the stages of an
+ * operation never add up to more than the operation itself. Keccak is a
+ * stage of its own, so e.g. matrix expansion is the rejection sampling
+ * around the XOF, not the XOF.
+ *
+ * Counters are kept per thread without locks; pqclean_bench_snapshot sums
+ * all threads, including ones that have exited. A snapshot taken while
+ * other threads are running is approximate to the last few operations.
+ * Cycles are rdtsc on x86 and nanoseconds elsewhere.
+ */
+typedef enum {
+    PQCLEAN_BENCH_SIGN,
+    PQCLEAN_BENCH_VERIFY,
+    PQCLEAN_BENCH_ENCAPS,
+    PQCLEAN_BENCH_DECAPS,
+    PQCLEAN_BENCH_OTHER,     /* stages run outside any operation (keygen, key setup) */
+    PQCLEAN_BENCH_OPS
+} pqclean_bench_op;
+
+typedef enum {
+    PQCLEAN_BENCH_MATRIX,    /* expansion of A from its seed */
+    PQCLEAN_BENCH_NTT,       /* NTT, inverse NTT, pointwise products */
+    PQCLEAN_BENCH_SAMPLE,    /* noise, mask and challenge sampling, norm checks */
+    PQCLEAN_BENCH_PACK,      /* (de)serialisation and (de)compression */
+    PQCLEAN_BENCH_HASH,      /* Keccak permutations */
+    PQCLEAN_BENCH_ARITH,     /* reductions, additions, rounding */
+    PQCLEAN_BENCH_STAGES
+} pqclean_bench_stage;
+
+typedef struct {
+    uint64_t ops[PQCLEAN_BENCH_OPS];                          /* completed operations */
+    uint64_t cycles[PQCLEAN_BENCH_OPS];                       /* cycles inside operations */
+    uint64_t stage[PQCLEAN_BENCH_OPS][PQCLEAN_BENCH_STAGES];  /* self cycles per stage */
+} pqclean_bench_report;
+
+/* 1 if the library was built with PQCLEAN_BENCH, 0 otherwise. */
+int pqclean_bench_enabled(void);
+
+/* Sum of all threads' counters since start. */
+void pqclean_bench_snapshot(pqclean_bench_report *report);
+
+/* Report minus an earlier snapshot of it, e.g. for one measurement window. */
+void pqclean_bench_diff(pqclean_bench_report *report, const pqclean_bench_report *since);
+
+/* Table of cycles/op per stage and operation; nothing if report has no data. */
+void pqclean_bench_print(FILE *out, const pqclean_bench_report *report);
+
+const char *pqclean_bench_op_name(pqclean_bench_op op);
+const char *pqclean_bench_stage_name(pqclean_bench_stage stage);
+
+/* Marker back end; use the macros below. */
+uint64_t pqclean_bench_enter(void);
+uint64_t pqclean_bench_leave(uint64_t start);
+uint64_t *pqclean_bench_counter(pqclean_bench_stage stage);
+void pqclean_bench_op_start(pqclean_bench_op op);
+void pqclean_bench_op_stop(void);
+
+#ifdef PQCLEAN_BENCH
+#define DBENCH_START() uint64_t dbench_time = pqclean_bench_enter()
+#define DBENCH_STOP(t) (t) += pqclean_bench_leave(dbench_time)
+#define DBENCH_OP_START(op) pqclean_bench_op_start(op)
+#define DBENCH_OP_STOP() pqclean_bench_op_stop()
+
+/* Stage counters named as in the reference implementation's markers */
+#define tmatrix (pqclean_bench_counter(PQCLEAN_BENCH_MATRIX))
+#define tmul (pqclean_bench_counter(PQCLEAN_BENCH_NTT))
+#define tsample (pqclean_bench_counter(PQCLEAN_BENCH_SAMPLE))
+#define tpack (pqclean_bench_counter(PQCLEAN_BENCH_PACK))
+#define thash (pqclean_bench_counter(PQCLEAN_BENCH_HASH))
+#define tred (pqclean_bench_counter(PQCLEAN_BENCH_ARITH))
+#define tadd (pqclean_bench_counter(PQCLEAN_BENCH_ARITH))
+#define tround (pqclean_bench_counter(PQCLEAN_BENCH_ARITH))
+#else
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+#define DBENCH_OP_START(op)
+#define DBENCH_OP_STOP()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PQCLEAN_PQBENCH_H */
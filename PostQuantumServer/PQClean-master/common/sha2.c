@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ctxalloc.h"
 #include "sha2.h"
 
 static uint32_t load_bigendian_32(const uint8_t *x) {
@@ -495,10 +496,7 @@ static const uint8_t iv_512[64] = {
 };
 
 void sha224_inc_init(sha224ctx *state) {
-    state->ctx = malloc(PQC_SHA256CTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHA256CTX_BYTES);
     for (size_t i = 0; i < 32; ++i) {
         state->ctx[i] = iv_224[i];
     }
@@ -508,10 +506,7 @@ void sha224_inc_init(sha224ctx *state) {
 }
 
 void sha256_inc_init(sha256ctx *state) {
-    state->ctx = malloc(PQC_SHA256CTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHA256CTX_BYTES);
     for (size_t i = 0; i < 32; ++i) {
         state->ctx[i] = iv_256[i];
     }
@@ -521,10 +516,7 @@ void sha256_inc_init(sha256ctx *state) {
 }
 
 void sha384_inc_init(sha384ctx *state) {
-    state->ctx = malloc(PQC_SHA512CTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHA512CTX_BYTES);
     for (size_t i = 0; i < 64; ++i) {
         state->ctx[i] = iv_384[i];
     }
@@ -534,10 +526,7 @@ void sha384_inc_init(sha384ctx *state) {
 }
 
 void sha512_inc_init(sha512ctx *state) {
-    state->ctx = malloc(PQC_SHA512CTX_BYTES);
-    if (state->ctx == NULL) {
-        exit(111);
-    }
+    state->ctx = pqclean_ctx_alloc(PQC_SHA512CTX_BYTES);
     for (size_t i = 0; i < 64; ++i) {
         state->ctx[i] = iv_512[i];
     }
@@ -547,55 +536,43 @@ void sha512_inc_init(sha512ctx *state) {
 }
 
 void sha224_inc_ctx_clone(sha224ctx *stateout, const sha224ctx *statein) {
-    stateout->ctx = malloc(PQC_SHA256CTX_BYTES);
-    if (stateout->ctx == NULL) {
-        exit(111);
-    }
+    stateout->ctx = pqclean_ctx_alloc(PQC_SHA256CTX_BYTES);
     memcpy(stateout->ctx, statein->ctx, PQC_SHA256CTX_BYTES);
 }
 
 void sha256_inc_ctx_clone(sha256ctx *stateout, const sha256ctx *statein) {
-    stateout->ctx = malloc(PQC_SHA256CTX_BYTES);
-    if (stateout->ctx == NULL) {
-        exit(111);
-    }
+    stateout->ctx = pqclean_ctx_alloc(PQC_SHA256CTX_BYTES);
     memcpy(stateout->ctx, statein->ctx, PQC_SHA256CTX_BYTES);
 }
 
 void sha384_inc_ctx_clone(sha384ctx *stateout, const sha384ctx *statein) {
-    stateout->ctx = malloc(PQC_SHA512CTX_BYTES);
-    if (stateout->ctx == NULL) {
-        exit(111);
-    }
+    stateout->ctx = pqclean_ctx_alloc(PQC_SHA512CTX_BYTES);
     memcpy(stateout->ctx, statein->ctx, PQC_SHA512CTX_BYTES);
 }
 
 void sha512_inc_ctx_clone(sha512ctx *stateout, const sha512ctx *statein) {
-    stateout->ctx = malloc(PQC_SHA512CTX_BYTES);
-    if (stateout->ctx == NULL) {
-        exit(111);
-    }
+    stateout->ctx = pqclean_ctx_alloc(PQC_SHA512CTX_BYTES);
     memcpy(stateout->ctx, statein->ctx, PQC_SHA512CTX_BYTES);
 }
 
 /* Destroy the hash state. */
 void sha224_inc_ctx_release(sha224ctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHA256CTX_BYTES);
 }
 
 /* Destroy the hash state. */
 void sha256_inc_ctx_release(sha256ctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHA256CTX_BYTES);
 }
 
 /* Destroy the hash state. */
 void sha384_inc_ctx_release(sha384ctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHA512CTX_BYTES);
 }
 
 /* Destroy the hash state. */
 void sha512_inc_ctx_release(sha512ctx *state) {
-    free(state->ctx);
+    pqclean_ctx_free(state->ctx, PQC_SHA512CTX_BYTES);
 }
 
 void sha256_inc_blocks(sha256ctx *state, const uint8_t *in, size_t inblocks) {
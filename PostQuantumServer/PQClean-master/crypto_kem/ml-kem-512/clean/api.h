@@ -9,10 +9,28 @@
 #define PQCLEAN_MLKEM512_CLEAN_CRYPTO_BYTES           32
 #define PQCLEAN_MLKEM512_CLEAN_CRYPTO_ALGNAME "ML-KEM-512"
 
+/* Key prepared for repeated encapsulation/decapsulation (see crypto_kem_key_new) */
+#ifndef PQCLEAN_MLKEM512_CLEAN_KEMKEY_T
+#define PQCLEAN_MLKEM512_CLEAN_KEMKEY_T
+typedef struct PQCLEAN_MLKEM512_CLEAN_kemkey PQCLEAN_MLKEM512_CLEAN_kemkey;
+#endif
+
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(uint8_t *pk, uint8_t *sk);
 
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
 
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 
+PQCLEAN_MLKEM512_CLEAN_kemkey *PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_new(const uint8_t *sk);
+
+PQCLEAN_MLKEM512_CLEAN_kemkey *PQCLEAN_MLKEM512_CLEAN_crypto_kem_pubkey_new(const uint8_t *pk);
+
+void PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_free(PQCLEAN_MLKEM512_CLEAN_kemkey *key);
+
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key(uint8_t *ct, uint8_t *ss,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key);
+
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec_key(uint8_t *ss, const uint8_t *ct,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key);
+
 #endif
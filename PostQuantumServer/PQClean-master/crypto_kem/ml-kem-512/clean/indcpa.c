@@ -3,11 +3,16 @@
 #include "params.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "pqbench.h"
 #include "randombytes.h"
+#include "rejsample.h"
 #include "symmetric.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
+#ifdef PQCLEAN_USE_KECCAK4X
+#include "fips202x4.h"
+#endif
 
 /*************************************************
 * Name:        pack_pk
@@ -23,8 +28,10 @@
 static void pack_pk(uint8_t r[KYBER_INDCPA_PUBLICKEYBYTES],
                     polyvec *pk,
                     const uint8_t seed[KYBER_SYMBYTES]) {
+    DBENCH_START();
     PQCLEAN_MLKEM512_CLEAN_polyvec_tobytes(r, pk);
     memcpy(r + KYBER_POLYVECBYTES, seed, KYBER_SYMBYTES);
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -40,8 +47,10 @@ static void pack_pk(uint8_t r[KYBER_INDCPA_PUBLICKEYBYTES],
 static void unpack_pk(polyvec *pk,
                       uint8_t seed[KYBER_SYMBYTES],
                       const uint8_t packedpk[KYBER_INDCPA_PUBLICKEYBYTES]) {
+    DBENCH_START();
     PQCLEAN_MLKEM512_CLEAN_polyvec_frombytes(pk, packedpk);
     memcpy(seed, packedpk + KYBER_POLYVECBYTES, KYBER_SYMBYTES);
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -53,7 +62,9 @@ static void unpack_pk(polyvec *pk,
 *              - polyvec *sk: pointer to input vector of polynomials (secret key)
 **************************************************/
 static void pack_sk(uint8_t r[KYBER_INDCPA_SECRETKEYBYTES], polyvec *sk) {
+    DBENCH_START();
     PQCLEAN_MLKEM512_CLEAN_polyvec_tobytes(r, sk);
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -65,7 +76,9 @@ static void pack_sk(uint8_t r[KYBER_INDCPA_SECRETKEYBYTES], polyvec *sk) {
 *              - const uint8_t *packedsk: pointer to input serialized secret key
 **************************************************/
 static void unpack_sk(polyvec *sk, const uint8_t packedsk[KYBER_INDCPA_SECRETKEYBYTES]) {
+    DBENCH_START();
     PQCLEAN_MLKEM512_CLEAN_polyvec_frombytes(sk, packedsk);
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -80,8 +93,10 @@ static void unpack_sk(polyvec *sk, const uint8_t packedsk[KYBER_INDCPA_SECRETKEY
 *              poly *v: pointer to the input polynomial v
 **************************************************/
 static void pack_ciphertext(uint8_t r[KYBER_INDCPA_BYTES], polyvec *b, poly *v) {
+    DBENCH_START();
     PQCLEAN_MLKEM512_CLEAN_polyvec_compress(r, b);
     PQCLEAN_MLKEM512_CLEAN_poly_compress(r + KYBER_POLYVECCOMPRESSEDBYTES, v);
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -95,15 +110,18 @@ static void pack_ciphertext(uint8_t r[KYBER_INDCPA_BYTES], polyvec *b, poly *v)
 *              - const uint8_t *c: pointer to the input serialized ciphertext
 **************************************************/
 static void unpack_ciphertext(polyvec *b, poly *v, const uint8_t c[KYBER_INDCPA_BYTES]) {
+    DBENCH_START();
     PQCLEAN_MLKEM512_CLEAN_polyvec_decompress(b, c);
     PQCLEAN_MLKEM512_CLEAN_poly_decompress(v, c + KYBER_POLYVECCOMPRESSEDBYTES);
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
-* Name:        rej_uniform
+* Name:        PQCLEAN_MLKEM512_CLEAN_rej_uniform
 *
 * Description: Run rejection sampling on uniform random bytes to generate
-*              uniform random integers mod q
+*              uniform random integers mod q (portable C; the reference
+*              for the AVX2 sampler)
 *
 * Arguments:   - int16_t *r: pointer to output buffer
 *              - unsigned int len: requested number of 16-bit integers (uniform mod q)
@@ -112,10 +130,10 @@ static void unpack_ciphertext(polyvec *b, poly *v, const uint8_t c[KYBER_INDCPA_
 *
 * Returns number of sampled 16-bit integers (at most len)
 **************************************************/
-static unsigned int rej_uniform(int16_t *r,
-                                unsigned int len,
-                                const uint8_t *buf,
-                                unsigned int buflen) {
+unsigned int PQCLEAN_MLKEM512_CLEAN_rej_uniform(int16_t *r,
+        unsigned int len,
+        const uint8_t *buf,
+        unsigned int buflen) {
     unsigned int ctr, pos;
     uint16_t val0, val1;
 
@@ -136,6 +154,19 @@ static unsigned int rej_uniform(int16_t *r,
     return ctr;
 }
 
+/* Rejection sampling with the AVX2 sampler when the CPU supports it */
+static unsigned int rej_uniform(int16_t *r,
+                                unsigned int len,
+                                const uint8_t *buf,
+                                unsigned int buflen) {
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        return PQCLEAN_MLKEM512_CLEAN_rej_uniform_avx2(r, len, buf, buflen);
+    }
+#endif
+    return PQCLEAN_MLKEM512_CLEAN_rej_uniform(r, len, buf, buflen);
+}
+
 #define gen_a(A,B)  PQCLEAN_MLKEM512_CLEAN_gen_matrix(A,B,0)
 #define gen_at(A,B) PQCLEAN_MLKEM512_CLEAN_gen_matrix(A,B,1)
 
@@ -153,33 +184,93 @@ static unsigned int rej_uniform(int16_t *r,
 **************************************************/
 
 #define GEN_MATRIX_NBLOCKS ((12*KYBER_N/8*(1 << 12)/KYBER_Q + XOF_BLOCKBYTES)/XOF_BLOCKBYTES)
+
+#ifdef PQCLEAN_USE_KECCAK4X
+/*************************************************
+* Name:        gen_matrix_x4
+*
+* Description: Samples four matrix entries with four parallel SHAKE128
+*              streams; every entry equals its serially sampled version
+*
+* Arguments:   - poly **r: four output polynomials
+*              - const uint8_t *seed: pointer to input seed
+*              - const uint8_t *x: first extra seed byte of each entry
+*              - const uint8_t *y: second extra seed byte of each entry
+**************************************************/
+static void gen_matrix_x4(poly *r[4], const uint8_t seed[KYBER_SYMBYTES], const uint8_t x[4], const uint8_t y[4]) {
+    unsigned int ctr[4], j;
+    uint8_t extseed[4][KYBER_SYMBYTES + 2];
+    uint8_t buf[4][GEN_MATRIX_NBLOCKS * XOF_BLOCKBYTES];
+    keccakx4_state state;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(extseed[j], seed, KYBER_SYMBYTES);
+        extseed[j][KYBER_SYMBYTES + 0] = x[j];
+        extseed[j][KYBER_SYMBYTES + 1] = y[j];
+    }
+    shake128x4_absorb_once(&state, extseed[0], extseed[1], extseed[2], extseed[3], KYBER_SYMBYTES + 2);
+    shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], GEN_MATRIX_NBLOCKS, &state);
+    for (j = 0; j < 4; j++) {
+        ctr[j] = rej_uniform(r[j]->coeffs, KYBER_N, buf[j], GEN_MATRIX_NBLOCKS * XOF_BLOCKBYTES);
+    }
+
+    while (ctr[0] < KYBER_N || ctr[1] < KYBER_N || ctr[2] < KYBER_N || ctr[3] < KYBER_N) {
+        shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], 1, &state);
+        for (j = 0; j < 4; j++) {
+            ctr[j] += rej_uniform(r[j]->coeffs + ctr[j], KYBER_N - ctr[j], buf[j], XOF_BLOCKBYTES);
+        }
+    }
+}
+#endif
+
 // Not static for benchmarking
 void PQCLEAN_MLKEM512_CLEAN_gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed) {
-    unsigned int ctr, i, j;
+    unsigned int ctr, i, j, k = 0;
     unsigned int buflen;
     uint8_t buf[GEN_MATRIX_NBLOCKS * XOF_BLOCKBYTES];
     xof_state state;
-
-    for (i = 0; i < KYBER_K; i++) {
-        for (j = 0; j < KYBER_K; j++) {
-            if (transposed) {
-                xof_absorb(&state, seed, (uint8_t)i, (uint8_t)j);
-            } else {
-                xof_absorb(&state, seed, (uint8_t)j, (uint8_t)i);
+    DBENCH_START();
+
+#ifdef PQCLEAN_USE_KECCAK4X
+    poly *r[4];
+    uint8_t x[4], y[4];
+    unsigned int n;
+
+    /* Entries in row-major order, four at a time (AVX2 CPUs only) */
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        for (; k + 4 <= KYBER_K * KYBER_K; k += 4) {
+            for (n = 0; n < 4; n++) {
+                i = (k + n) / KYBER_K;
+                j = (k + n) % KYBER_K;
+                r[n] = &a[i].vec[j];
+                x[n] = (uint8_t)(transposed ? i : j);
+                y[n] = (uint8_t)(transposed ? j : i);
             }
+            gen_matrix_x4(r, seed, x, y);
+        }
+    }
+#endif
+
+    for (; k < KYBER_K * KYBER_K; k++) {
+        i = k / KYBER_K;
+        j = k % KYBER_K;
+        if (transposed) {
+            xof_absorb(&state, seed, (uint8_t)i, (uint8_t)j);
+        } else {
+            xof_absorb(&state, seed, (uint8_t)j, (uint8_t)i);
+        }
 
-            xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
-            buflen = GEN_MATRIX_NBLOCKS * XOF_BLOCKBYTES;
-            ctr = rej_uniform(a[i].vec[j].coeffs, KYBER_N, buf, buflen);
+        xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
+        buflen = GEN_MATRIX_NBLOCKS * XOF_BLOCKBYTES;
+        ctr = rej_uniform(a[i].vec[j].coeffs, KYBER_N, buf, buflen);
 
-            while (ctr < KYBER_N) {
-                xof_squeezeblocks(buf, 1, &state);
-                buflen = XOF_BLOCKBYTES;
-                ctr += rej_uniform(a[i].vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
-            }
-            xof_ctx_release(&state);
+        while (ctr < KYBER_N) {
+            xof_squeezeblocks(buf, 1, &state);
+            buflen = XOF_BLOCKBYTES;
+            ctr += rej_uniform(a[i].vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
         }
     }
+    DBENCH_STOP(*tmatrix);
 }
 
 /*************************************************
@@ -202,7 +293,6 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLIC
     uint8_t buf[2 * KYBER_SYMBYTES];
     const uint8_t *publicseed = buf;
     const uint8_t *noiseseed = buf + KYBER_SYMBYTES;
-    uint8_t nonce = 0;
     polyvec a[KYBER_K], e, pkpv, skpv;
 
     memcpy(buf, coins, KYBER_SYMBYTES);
@@ -211,12 +301,8 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLIC
 
     gen_a(a, publicseed);
 
-    for (i = 0; i < KYBER_K; i++) {
-        PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(&skpv.vec[i], noiseseed, nonce++);
-    }
-    for (i = 0; i < KYBER_K; i++) {
-        PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(&e.vec[i], noiseseed, nonce++);
-    }
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1_4x(&skpv.vec[0], &skpv.vec[1], &e.vec[0], &e.vec[1],
+            noiseseed, 0, 1, 2, 3);
 
     PQCLEAN_MLKEM512_CLEAN_polyvec_ntt(&skpv);
     PQCLEAN_MLKEM512_CLEAN_polyvec_ntt(&e);
@@ -236,42 +322,70 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLIC
 
 
 /*************************************************
-* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_enc
+* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_pk
 *
-* Description: Encryption function of the CPA-secure
-*              public-key encryption scheme underlying Kyber.
+* Description: Unpacks a public key and expands the transposed matrix
+*              A^T from its seed, i.e. everything indcpa_enc derives
+*              from the public key alone.
+*
+* Arguments:   - polyvec *at: pointer to output matrix A^T (KYBER_K rows)
+*              - polyvec *pkpv: pointer to output public vector (NTT domain)
+*              - const uint8_t *pk: pointer to input public key
+*                                   (of length KYBER_INDCPA_PUBLICKEYBYTES)
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_pk(polyvec at[KYBER_K],
+        polyvec *pkpv,
+        const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES]) {
+    uint8_t seed[KYBER_SYMBYTES];
+
+    unpack_pk(pkpv, seed, pk);
+    gen_at(at, seed);
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_sk
+*
+* Description: Unpacks a secret key to its NTT-domain vector.
+*
+* Arguments:   - polyvec *skpv: pointer to output secret vector
+*              - const uint8_t *sk: pointer to input secret key
+*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_sk(polyvec *skpv,
+        const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]) {
+    unpack_sk(skpv, sk);
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_enc_prepared
+*
+* Description: Encryption with a public key already unpacked by
+*              indcpa_prepare_pk.
 *
 * Arguments:   - uint8_t *c: pointer to output ciphertext
 *                            (of length KYBER_INDCPA_BYTES bytes)
 *              - const uint8_t *m: pointer to input message
 *                                  (of length KYBER_INDCPA_MSGBYTES bytes)
-*              - const uint8_t *pk: pointer to input public key
-*                                   (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const polyvec *at: pointer to expanded matrix A^T
+*              - const polyvec *pkpv: pointer to public vector (NTT domain)
 *              - const uint8_t *coins: pointer to input random coins used as seed
 *                                      (of length KYBER_SYMBYTES) to deterministically
 *                                      generate all randomness
 **************************************************/
-void PQCLEAN_MLKEM512_CLEAN_indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
-                                       const uint8_t m[KYBER_INDCPA_MSGBYTES],
-                                       const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                                       const uint8_t coins[KYBER_SYMBYTES]) {
+void PQCLEAN_MLKEM512_CLEAN_indcpa_enc_prepared(uint8_t c[KYBER_INDCPA_BYTES],
+        const uint8_t m[KYBER_INDCPA_MSGBYTES],
+        const polyvec at[KYBER_K],
+        const polyvec *pkpv,
+        const uint8_t coins[KYBER_SYMBYTES]) {
     unsigned int i;
-    uint8_t seed[KYBER_SYMBYTES];
-    uint8_t nonce = 0;
-    polyvec sp, pkpv, ep, at[KYBER_K], b;
+    polyvec sp, ep, b;
     poly v, k, epp;
 
-    unpack_pk(&pkpv, seed, pk);
     PQCLEAN_MLKEM512_CLEAN_poly_frommsg(&k, m);
-    gen_at(at, seed);
 
-    for (i = 0; i < KYBER_K; i++) {
-        PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(sp.vec + i, coins, nonce++);
-    }
-    for (i = 0; i < KYBER_K; i++) {
-        PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(ep.vec + i, coins, nonce++);
-    }
-    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(&epp, coins, nonce++);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1122_4x(sp.vec + 0, sp.vec + 1, ep.vec + 0, ep.vec + 1,
+            coins, 0, 1, 2, 3);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(&epp, coins, 4);
 
     PQCLEAN_MLKEM512_CLEAN_polyvec_ntt(&sp);
 
@@ -280,7 +394,7 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
         PQCLEAN_MLKEM512_CLEAN_polyvec_basemul_acc_montgomery(&b.vec[i], &at[i], &sp);
     }
 
-    PQCLEAN_MLKEM512_CLEAN_polyvec_basemul_acc_montgomery(&v, &pkpv, &sp);
+    PQCLEAN_MLKEM512_CLEAN_polyvec_basemul_acc_montgomery(&v, pkpv, &sp);
 
     PQCLEAN_MLKEM512_CLEAN_polyvec_invntt_tomont(&b);
     PQCLEAN_MLKEM512_CLEAN_poly_invntt_tomont(&v);
@@ -295,29 +409,53 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
 }
 
 /*************************************************
-* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_dec
+* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_enc
 *
-* Description: Decryption function of the CPA-secure
+* Description: Encryption function of the CPA-secure
 *              public-key encryption scheme underlying Kyber.
 *
+* Arguments:   - uint8_t *c: pointer to output ciphertext
+*                            (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m: pointer to input message
+*                                  (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk: pointer to input public key
+*                                   (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins used as seed
+*                                      (of length KYBER_SYMBYTES) to deterministically
+*                                      generate all randomness
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                                       const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                                       const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                                       const uint8_t coins[KYBER_SYMBYTES]) {
+    polyvec pkpv, at[KYBER_K];
+
+    PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_pk(at, &pkpv, pk);
+    PQCLEAN_MLKEM512_CLEAN_indcpa_enc_prepared(c, m, at, &pkpv, coins);
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_dec_prepared
+*
+* Description: Decryption with a secret key already unpacked by
+*              indcpa_prepare_sk.
+*
 * Arguments:   - uint8_t *m: pointer to output decrypted message
 *                            (of length KYBER_INDCPA_MSGBYTES)
 *              - const uint8_t *c: pointer to input ciphertext
 *                                  (of length KYBER_INDCPA_BYTES)
-*              - const uint8_t *sk: pointer to input secret key
-*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+*              - const polyvec *skpv: pointer to secret vector (NTT domain)
 **************************************************/
-void PQCLEAN_MLKEM512_CLEAN_indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
-                                       const uint8_t c[KYBER_INDCPA_BYTES],
-                                       const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]) {
-    polyvec b, skpv;
+void PQCLEAN_MLKEM512_CLEAN_indcpa_dec_prepared(uint8_t m[KYBER_INDCPA_MSGBYTES],
+        const uint8_t c[KYBER_INDCPA_BYTES],
+        const polyvec *skpv) {
+    polyvec b;
     poly v, mp;
 
     unpack_ciphertext(&b, &v, c);
-    unpack_sk(&skpv, sk);
 
     PQCLEAN_MLKEM512_CLEAN_polyvec_ntt(&b);
-    PQCLEAN_MLKEM512_CLEAN_polyvec_basemul_acc_montgomery(&mp, &skpv, &b);
+    PQCLEAN_MLKEM512_CLEAN_polyvec_basemul_acc_montgomery(&mp, skpv, &b);
     PQCLEAN_MLKEM512_CLEAN_poly_invntt_tomont(&mp);
 
     PQCLEAN_MLKEM512_CLEAN_poly_sub(&mp, &v, &mp);
@@ -325,3 +463,25 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
 
     PQCLEAN_MLKEM512_CLEAN_poly_tomsg(m, &mp);
 }
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_indcpa_dec
+*
+* Description: Decryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *m: pointer to output decrypted message
+*                            (of length KYBER_INDCPA_MSGBYTES)
+*              - const uint8_t *c: pointer to input ciphertext
+*                                  (of length KYBER_INDCPA_BYTES)
+*              - const uint8_t *sk: pointer to input secret key
+*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                                       const uint8_t c[KYBER_INDCPA_BYTES],
+                                       const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]) {
+    polyvec skpv;
+
+    PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_sk(&skpv, sk);
+    PQCLEAN_MLKEM512_CLEAN_indcpa_dec_prepared(m, c, &skpv);
+}
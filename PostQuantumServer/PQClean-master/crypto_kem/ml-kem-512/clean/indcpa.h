@@ -19,4 +19,21 @@ void PQCLEAN_MLKEM512_CLEAN_indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
                                        const uint8_t c[KYBER_INDCPA_BYTES],
                                        const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
 
+void PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_pk(polyvec at[KYBER_K],
+        polyvec *pkpv,
+        const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES]);
+
+void PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_sk(polyvec *skpv,
+        const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
+
+void PQCLEAN_MLKEM512_CLEAN_indcpa_enc_prepared(uint8_t c[KYBER_INDCPA_BYTES],
+        const uint8_t m[KYBER_INDCPA_MSGBYTES],
+        const polyvec at[KYBER_K],
+        const polyvec *pkpv,
+        const uint8_t coins[KYBER_SYMBYTES]);
+
+void PQCLEAN_MLKEM512_CLEAN_indcpa_dec_prepared(uint8_t m[KYBER_INDCPA_MSGBYTES],
+        const uint8_t c[KYBER_INDCPA_BYTES],
+        const polyvec *skpv);
+
 #endif
@@ -1,12 +1,69 @@
 #include "indcpa.h"
 #include "kem.h"
 #include "params.h"
+#include "pqbench.h"
 #include "randombytes.h"
 #include "symmetric.h"
 #include "verify.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+/*************************************************
+* Name:        key_expand_pk
+*
+* Description: Fills the public part of a prepared key: unpacks t,
+*              expands A^T and stores H(pk).
+*
+* Arguments:   - kemkey *key: pointer to output prepared key
+*              - const uint8_t *pk: pointer to input public key
+*                (an already allocated array of KYBER_PUBLICKEYBYTES bytes)
+*              - const uint8_t *hpk: H(pk) if already known, else NULL
+**************************************************/
+static void key_expand_pk(PQCLEAN_MLKEM512_CLEAN_kemkey *key, const uint8_t *pk, const uint8_t *hpk) {
+    PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_pk(key->at, &key->pkpv, pk);
+    if (hpk != NULL) {
+        memcpy(key->hpk, hpk, KYBER_SYMBYTES);
+    } else {
+        hash_h(key->hpk, pk, KYBER_PUBLICKEYBYTES);
+    }
+    key->has_sk = 0;
+}
+
+/*************************************************
+* Name:        key_expand_sk
+*
+* Description: Fills a prepared key from a full secret key, which also
+*              carries the public key, H(pk) and the rejection value z.
+*
+* Arguments:   - kemkey *key: pointer to output prepared key
+*              - const uint8_t *sk: pointer to input private key
+*                (an already allocated array of KYBER_SECRETKEYBYTES bytes)
+**************************************************/
+static void key_expand_sk(PQCLEAN_MLKEM512_CLEAN_kemkey *key, const uint8_t *sk) {
+    key_expand_pk(key, sk + KYBER_INDCPA_SECRETKEYBYTES, sk + KYBER_SECRETKEYBYTES - 2 * KYBER_SYMBYTES);
+    PQCLEAN_MLKEM512_CLEAN_indcpa_prepare_sk(&key->skpv, sk);
+    memcpy(key->z, sk + KYBER_SECRETKEYBYTES - KYBER_SYMBYTES, KYBER_SYMBYTES);
+    key->has_sk = 1;
+}
+
+/*************************************************
+* Name:        key_wipe
+*
+* Description: Overwrites a prepared key so the secret part does not
+*              linger in memory.
+*
+* Arguments:   - kemkey *key: pointer to prepared key
+**************************************************/
+static void key_wipe(PQCLEAN_MLKEM512_CLEAN_kemkey *key) {
+    volatile uint8_t *p = (volatile uint8_t *)key;
+    size_t i;
+
+    for (i = 0; i < sizeof(*key); ++i) {
+        p[i] = 0;
+    }
+}
+
 /*************************************************
 * Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair_derand
 *
@@ -75,20 +132,12 @@ int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_derand(uint8_t *ct,
         uint8_t *ss,
         const uint8_t *pk,
         const uint8_t *coins) {
-    uint8_t buf[2 * KYBER_SYMBYTES];
-    /* Will contain key, coins */
-    uint8_t kr[2 * KYBER_SYMBYTES];
+    PQCLEAN_MLKEM512_CLEAN_kemkey key;
 
-    memcpy(buf, coins, KYBER_SYMBYTES);
-
-    /* Multitarget countermeasure for coins + contributory KEM */
-    hash_h(buf + KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
-    hash_g(kr, buf, 2 * KYBER_SYMBYTES);
-
-    /* coins are in kr+KYBER_SYMBYTES */
-    PQCLEAN_MLKEM512_CLEAN_indcpa_enc(ct, buf, pk, kr + KYBER_SYMBYTES);
-
-    memcpy(ss, kr, KYBER_SYMBYTES);
+    DBENCH_OP_START(PQCLEAN_BENCH_ENCAPS);
+    key_expand_pk(&key, pk, NULL);
+    PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key_derand(ct, ss, &key, coins);
+    DBENCH_OP_STOP();
     return 0;
 }
 
@@ -136,29 +185,191 @@ int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(uint8_t *ct,
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(uint8_t *ss,
         const uint8_t *ct,
         const uint8_t *sk) {
+    PQCLEAN_MLKEM512_CLEAN_kemkey key;
+    int ret;
+
+    DBENCH_OP_START(PQCLEAN_BENCH_DECAPS);
+    key_expand_sk(&key, sk);
+    ret = PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec_key(ss, ct, &key);
+    key_wipe(&key);
+    DBENCH_OP_STOP();
+    return ret;
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_new
+*
+* Description: Creates a prepared key from a secret key: t and s are
+*              unpacked to the NTT domain and the matrix A^T is expanded
+*              once, so repeated encapsulations and decapsulations skip
+*              all key-dependent setup (in particular the SHAKE128 matrix
+*              expansion that decapsulation needs for re-encryption).
+*
+* Arguments:   - const uint8_t *sk: pointer to input private key
+*                (an already allocated array of KYBER_SECRETKEYBYTES bytes)
+*
+* Returns pointer to the key or NULL if allocation failed
+**************************************************/
+PQCLEAN_MLKEM512_CLEAN_kemkey *PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_new(const uint8_t *sk) {
+    PQCLEAN_MLKEM512_CLEAN_kemkey *key = malloc(sizeof(PQCLEAN_MLKEM512_CLEAN_kemkey));
+
+    if (key == NULL) {
+        return NULL;
+    }
+    key_expand_sk(key, sk);
+    return key;
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_pubkey_new
+*
+* Description: Creates a prepared key from a public key; it can only be
+*              used for encapsulation.
+*
+* Arguments:   - const uint8_t *pk: pointer to input public key
+*                (an already allocated array of KYBER_PUBLICKEYBYTES bytes)
+*
+* Returns pointer to the key or NULL if allocation failed
+**************************************************/
+PQCLEAN_MLKEM512_CLEAN_kemkey *PQCLEAN_MLKEM512_CLEAN_crypto_kem_pubkey_new(const uint8_t *pk) {
+    PQCLEAN_MLKEM512_CLEAN_kemkey *key = malloc(sizeof(PQCLEAN_MLKEM512_CLEAN_kemkey));
+
+    if (key == NULL) {
+        return NULL;
+    }
+    key_wipe(key);
+    key_expand_pk(key, pk, NULL);
+    return key;
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_free
+*
+* Description: Wipes and frees a prepared key.
+*
+* Arguments:   - kemkey *key: pointer to prepared key (may be NULL)
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_free(PQCLEAN_MLKEM512_CLEAN_kemkey *key) {
+    if (key == NULL) {
+        return;
+    }
+    key_wipe(key);
+    free(key);
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key_derand
+*
+* Description: Generates cipher text and shared secret for a prepared key.
+*              Output is identical to crypto_kem_enc_derand with the
+*              key's public key.
+*
+* Arguments:   - uint8_t *ct: pointer to output cipher text
+*                (an already allocated array of KYBER_CIPHERTEXTBYTES bytes)
+*              - uint8_t *ss: pointer to output shared secret
+*                (an already allocated array of KYBER_SSBYTES bytes)
+*              - const kemkey *key: pointer to prepared key
+*              - const uint8_t *coins: pointer to input randomness
+*                (an already allocated array filled with KYBER_SYMBYTES random bytes)
+**
+* Returns 0 (success)
+**************************************************/
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key_derand(uint8_t *ct,
+        uint8_t *ss,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key,
+        const uint8_t *coins) {
+    uint8_t buf[2 * KYBER_SYMBYTES];
+    /* Will contain key, coins */
+    uint8_t kr[2 * KYBER_SYMBYTES];
+
+    DBENCH_OP_START(PQCLEAN_BENCH_ENCAPS);
+    memcpy(buf, coins, KYBER_SYMBYTES);
+
+    /* Multitarget countermeasure for coins + contributory KEM */
+    memcpy(buf + KYBER_SYMBYTES, key->hpk, KYBER_SYMBYTES);
+    hash_g(kr, buf, 2 * KYBER_SYMBYTES);
+
+    /* coins are in kr+KYBER_SYMBYTES */
+    PQCLEAN_MLKEM512_CLEAN_indcpa_enc_prepared(ct, buf, key->at, &key->pkpv, kr + KYBER_SYMBYTES);
+
+    memcpy(ss, kr, KYBER_SYMBYTES);
+    DBENCH_OP_STOP();
+    return 0;
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key
+*
+* Description: Generates cipher text and shared secret for a prepared key.
+*
+* Arguments:   - uint8_t *ct: pointer to output cipher text
+*                (an already allocated array of KYBER_CIPHERTEXTBYTES bytes)
+*              - uint8_t *ss: pointer to output shared secret
+*                (an already allocated array of KYBER_SSBYTES bytes)
+*              - const kemkey *key: pointer to prepared key
+*
+* Returns 0 (success)
+**************************************************/
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key(uint8_t *ct,
+        uint8_t *ss,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key) {
+    uint8_t coins[KYBER_SYMBYTES];
+    randombytes(coins, KYBER_SYMBYTES);
+    PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key_derand(ct, ss, key, coins);
+    return 0;
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec_key
+*
+* Description: Generates shared secret for given cipher text and a
+*              prepared key. Output is identical to crypto_kem_dec with
+*              the secret key the prepared key was made from.
+*
+* Arguments:   - uint8_t *ss: pointer to output shared secret
+*                (an already allocated array of KYBER_SSBYTES bytes)
+*              - const uint8_t *ct: pointer to input cipher text
+*                (an already allocated array of KYBER_CIPHERTEXTBYTES bytes)
+*              - const kemkey *key: pointer to prepared key
+*
+* Returns 0, or -1 if the key was prepared from a public key only; ss is
+* then set to all zeros.
+*
+* On decapsulation failure (invalid ciphertext), ss will contain a
+* pseudo-random value.
+**************************************************/
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec_key(uint8_t *ss,
+        const uint8_t *ct,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key) {
     int fail;
     uint8_t buf[2 * KYBER_SYMBYTES];
     /* Will contain key, coins */
     uint8_t kr[2 * KYBER_SYMBYTES];
     uint8_t cmp[KYBER_CIPHERTEXTBYTES + KYBER_SYMBYTES];
-    const uint8_t *pk = sk + KYBER_INDCPA_SECRETKEYBYTES;
 
-    PQCLEAN_MLKEM512_CLEAN_indcpa_dec(buf, ct, sk);
+    if (!key->has_sk) {
+        memset(ss, 0, KYBER_SSBYTES);
+        return -1;
+    }
+
+    DBENCH_OP_START(PQCLEAN_BENCH_DECAPS);
+    PQCLEAN_MLKEM512_CLEAN_indcpa_dec_prepared(buf, ct, &key->skpv);
 
     /* Multitarget countermeasure for coins + contributory KEM */
-    memcpy(buf + KYBER_SYMBYTES, sk + KYBER_SECRETKEYBYTES - 2 * KYBER_SYMBYTES, KYBER_SYMBYTES);
+    memcpy(buf + KYBER_SYMBYTES, key->hpk, KYBER_SYMBYTES);
     hash_g(kr, buf, 2 * KYBER_SYMBYTES);
 
     /* coins are in kr+KYBER_SYMBYTES */
-    PQCLEAN_MLKEM512_CLEAN_indcpa_enc(cmp, buf, pk, kr + KYBER_SYMBYTES);
+    PQCLEAN_MLKEM512_CLEAN_indcpa_enc_prepared(cmp, buf, key->at, &key->pkpv, kr + KYBER_SYMBYTES);
 
     fail = PQCLEAN_MLKEM512_CLEAN_verify(ct, cmp, KYBER_CIPHERTEXTBYTES);
 
     /* Compute rejection key */
-    rkprf(ss, sk + KYBER_SECRETKEYBYTES - KYBER_SYMBYTES, ct);
+    rkprf(ss, key->z, ct);
 
     /* Copy true key to return buffer if fail is false */
     PQCLEAN_MLKEM512_CLEAN_cmov(ss, kr, KYBER_SYMBYTES, (uint8_t) (1 - fail));
 
+    DBENCH_OP_STOP();
     return 0;
 }
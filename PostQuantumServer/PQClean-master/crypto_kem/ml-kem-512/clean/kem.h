@@ -1,6 +1,7 @@
 #ifndef PQCLEAN_MLKEM512_CLEAN_KEM_H
 #define PQCLEAN_MLKEM512_CLEAN_KEM_H
 #include "params.h"
+#include "polyvec.h"
 #include <stdint.h>
 
 #define PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES  KYBER_SECRETKEYBYTES
@@ -10,6 +11,20 @@
 
 #define PQCLEAN_MLKEM512_CLEAN_CRYPTO_ALGNAME "ML-KEM-512"
 
+/* Key unpacked to the NTT domain with the matrix A^T expanded */
+struct PQCLEAN_MLKEM512_CLEAN_kemkey {
+    polyvec at[KYBER_K];
+    polyvec pkpv;
+    polyvec skpv;
+    uint8_t hpk[KYBER_SYMBYTES];
+    uint8_t z[KYBER_SYMBYTES];
+    int has_sk;
+};
+#ifndef PQCLEAN_MLKEM512_CLEAN_KEMKEY_T
+#define PQCLEAN_MLKEM512_CLEAN_KEMKEY_T
+typedef struct PQCLEAN_MLKEM512_CLEAN_kemkey PQCLEAN_MLKEM512_CLEAN_kemkey;
+#endif
+
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
 
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(uint8_t *pk, uint8_t *sk);
@@ -20,4 +35,19 @@ int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(uint8_t *ct, uint8_t *ss, const uint8_
 
 int PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 
+PQCLEAN_MLKEM512_CLEAN_kemkey *PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_new(const uint8_t *sk);
+
+PQCLEAN_MLKEM512_CLEAN_kemkey *PQCLEAN_MLKEM512_CLEAN_crypto_kem_pubkey_new(const uint8_t *pk);
+
+void PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_free(PQCLEAN_MLKEM512_CLEAN_kemkey *key);
+
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key_derand(uint8_t *ct, uint8_t *ss,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key, const uint8_t *coins);
+
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key(uint8_t *ct, uint8_t *ss,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key);
+
+int PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec_key(uint8_t *ss, const uint8_t *ct,
+        const PQCLEAN_MLKEM512_CLEAN_kemkey *key);
+
 #endif
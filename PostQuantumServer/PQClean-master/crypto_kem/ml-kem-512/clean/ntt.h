@@ -11,4 +11,19 @@ void PQCLEAN_MLKEM512_CLEAN_invntt(int16_t r[256]);
 
 void PQCLEAN_MLKEM512_CLEAN_basemul(int16_t r[2], const int16_t a[2], const int16_t b[2], int16_t zeta);
 
+/* AVX2 kernels (ntt_avx2.c), used when the CPU reports AVX2 at runtime */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(PQCLEAN_NO_AVX2)
+#define PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+
+int PQCLEAN_MLKEM512_CLEAN_avx2_available(void);
+
+void PQCLEAN_MLKEM512_CLEAN_ntt_avx2(int16_t r[256]);
+
+void PQCLEAN_MLKEM512_CLEAN_invntt_avx2(int16_t r[256]);
+
+void PQCLEAN_MLKEM512_CLEAN_basemul_avx2(int16_t r[256], const int16_t a[256], const int16_t b[256]);
+
+void PQCLEAN_MLKEM512_CLEAN_reduce_avx2(int16_t r[256]);
+#endif
+
 #endif
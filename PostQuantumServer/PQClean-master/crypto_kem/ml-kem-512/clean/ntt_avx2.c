@@ -0,0 +1,290 @@
+#include "ntt.h"
+#include "params.h"
+#include "reduce.h"
+#include <stdint.h>
+
+/*
+ * AVX2 versions of the NTT, inverse NTT, base multiplication and Barrett
+ * reduction, 16 coefficients per instruction. Coefficients keep the clean
+ * (natural, bitreversed-NTT) order and every butterfly performs the same
+ * 16-bit operations as ntt.c, so results are bit-for-bit identical to the
+ * clean code. The functions are compiled for AVX2 via a target attribute
+ * and are only called when PQCLEAN_MLKEM512_CLEAN_avx2_available() says
+ * the CPU supports them.
+ */
+
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_avx2_available
+*
+* Description: Runtime CPUID check for AVX2.
+*
+* Returns 1 if the AVX2 kernels may be used, 0 otherwise
+**************************************************/
+int PQCLEAN_MLKEM512_CLEAN_avx2_available(void) {
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+}
+
+/* a*b*R^{-1} mod q in each lane; same result as fqmul() */
+AVX2 static inline __m256i fqmul_x16(__m256i a, __m256i b) {
+    const __m256i q = _mm256_set1_epi16(KYBER_Q);
+    const __m256i qinv = _mm256_set1_epi16(QINV);
+    __m256i lo = _mm256_mullo_epi16(a, b);
+    __m256i hi = _mm256_mulhi_epi16(a, b);
+    __m256i t = _mm256_mullo_epi16(lo, qinv);
+
+    t = _mm256_mulhi_epi16(t, q);
+    return _mm256_sub_epi16(hi, t);
+}
+
+/* Centered representative mod q in each lane; same result as barrett_reduce() */
+AVX2 static inline __m256i barrett_x16(__m256i a) {
+    const __m256i q = _mm256_set1_epi16(KYBER_Q);
+    const __m256i v = _mm256_set1_epi16(((1 << 26) + KYBER_Q / 2) / KYBER_Q);
+    const __m256i round = _mm256_set1_epi16(1 << 9);
+    __m256i t = _mm256_mulhi_epi16(a, v);
+
+    /* (v*a + 2^25) >> 26 == ((v*a >> 16) + 2^9) >> 10 */
+    t = _mm256_add_epi16(t, round);
+    t = _mm256_srai_epi16(t, 10);
+    t = _mm256_mullo_epi16(t, q);
+    return _mm256_sub_epi16(a, t);
+}
+
+/* 16-bit zeta replicated 4 or 2 times into a 64- or 32-bit lane */
+static inline int64_t rep4(int16_t z) {
+    return (int64_t)((uint64_t)(uint16_t)z * 0x0001000100010001ULL);
+}
+
+static inline int32_t rep2(int16_t z) {
+    return (int32_t)((uint32_t)(uint16_t)z * 0x00010001U);
+}
+
+/* Forward butterfly: (a, b) -> (a + zeta*b, a - zeta*b) */
+#define FWD_BUTTERFLY(A, B, Z) do {              \
+        __m256i t_ = fqmul_x16((Z), (B));        \
+        (B) = _mm256_sub_epi16((A), t_);         \
+        (A) = _mm256_add_epi16((A), t_);         \
+    } while (0)
+
+/* Inverse butterfly: (a, b) -> (barrett(a + b), zeta*(b - a)) */
+#define INV_BUTTERFLY(A, B, Z) do {              \
+        __m256i t_ = (A);                        \
+        (A) = barrett_x16(_mm256_add_epi16(t_, (B))); \
+        (B) = fqmul_x16((Z), _mm256_sub_epi16((B), t_)); \
+    } while (0)
+
+/*
+ * Layers with len >= 16 work on whole vectors. The three short layers work
+ * on two vectors (32 coefficients) at a time and first gather the "low"
+ * halves of all butterflies into one vector and the "high" halves into the
+ * other:
+ *   len 8: 128-bit halves  (permute2x128)
+ *   len 4: 64-bit quarters (unpack epi64)
+ *   len 2: 32-bit pairs    (shuffle epi32 + unpack epi64)
+ * zeta(g) below is the zeta of butterfly group g of the layer.
+ */
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_ntt_avx2
+*
+* Description: AVX2 version of PQCLEAN_MLKEM512_CLEAN_ntt.
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements of Zq
+**************************************************/
+AVX2 void PQCLEAN_MLKEM512_CLEAN_ntt_avx2(int16_t r[256]) {
+    const int16_t *zetas = PQCLEAN_MLKEM512_CLEAN_zetas;
+    unsigned int len, start, j, k;
+    __m256i a, b, z, v0, v1;
+
+    k = 1;
+    for (len = 128; len >= 16; len >>= 1) {
+        for (start = 0; start < 256; start += 2 * len) {
+            z = _mm256_set1_epi16(zetas[k++]);
+            for (j = start; j < start + len; j += 16) {
+                a = _mm256_loadu_si256((const __m256i *)&r[j]);
+                b = _mm256_loadu_si256((const __m256i *)&r[j + len]);
+                FWD_BUTTERFLY(a, b, z);
+                _mm256_storeu_si256((__m256i *)&r[j], a);
+                _mm256_storeu_si256((__m256i *)&r[j + len], b);
+            }
+        }
+    }
+
+    /* len = 8, groups k..k+1 per 32 coefficients (k = 16..31) */
+    for (start = 0; start < 256; start += 32, k += 2) {
+        v0 = _mm256_loadu_si256((const __m256i *)&r[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&r[start + 16]);
+        a = _mm256_permute2x128_si256(v0, v1, 0x20);
+        b = _mm256_permute2x128_si256(v0, v1, 0x31);
+        z = _mm256_setr_m128i(_mm_set1_epi16(zetas[k]), _mm_set1_epi16(zetas[k + 1]));
+        FWD_BUTTERFLY(a, b, z);
+        _mm256_storeu_si256((__m256i *)&r[start], _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)&r[start + 16], _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    /* len = 4, groups k..k+3 per 32 coefficients (k = 32..63) */
+    for (start = 0; start < 256; start += 32, k += 4) {
+        v0 = _mm256_loadu_si256((const __m256i *)&r[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&r[start + 16]);
+        a = _mm256_unpacklo_epi64(v0, v1);
+        b = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi64x(rep4(zetas[k]), rep4(zetas[k + 2]),
+                               rep4(zetas[k + 1]), rep4(zetas[k + 3]));
+        FWD_BUTTERFLY(a, b, z);
+        _mm256_storeu_si256((__m256i *)&r[start], _mm256_unpacklo_epi64(a, b));
+        _mm256_storeu_si256((__m256i *)&r[start + 16], _mm256_unpackhi_epi64(a, b));
+    }
+
+    /* len = 2, groups k..k+7 per 32 coefficients (k = 64..127) */
+    for (start = 0; start < 256; start += 32, k += 8) {
+        v0 = _mm256_loadu_si256((const __m256i *)&r[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&r[start + 16]);
+        v0 = _mm256_shuffle_epi32(v0, _MM_SHUFFLE(3, 1, 2, 0));
+        v1 = _mm256_shuffle_epi32(v1, _MM_SHUFFLE(3, 1, 2, 0));
+        a = _mm256_unpacklo_epi64(v0, v1);
+        b = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi32(rep2(zetas[k]), rep2(zetas[k + 1]), rep2(zetas[k + 4]), rep2(zetas[k + 5]),
+                              rep2(zetas[k + 2]), rep2(zetas[k + 3]), rep2(zetas[k + 6]), rep2(zetas[k + 7]));
+        FWD_BUTTERFLY(a, b, z);
+        _mm256_storeu_si256((__m256i *)&r[start], _mm256_unpacklo_epi32(a, b));
+        _mm256_storeu_si256((__m256i *)&r[start + 16], _mm256_unpackhi_epi32(a, b));
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_invntt_avx2
+*
+* Description: AVX2 version of PQCLEAN_MLKEM512_CLEAN_invntt.
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements of Zq
+**************************************************/
+AVX2 void PQCLEAN_MLKEM512_CLEAN_invntt_avx2(int16_t r[256]) {
+    const int16_t *zetas = PQCLEAN_MLKEM512_CLEAN_zetas;
+    const __m256i f = _mm256_set1_epi16(1441); // mont^2/128
+    unsigned int len, start, j, k;
+    __m256i a, b, z, v0, v1;
+
+    /* len = 2, groups use zetas 127 down to 64 */
+    k = 127;
+    for (start = 0; start < 256; start += 32, k -= 8) {
+        v0 = _mm256_loadu_si256((const __m256i *)&r[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&r[start + 16]);
+        v0 = _mm256_shuffle_epi32(v0, _MM_SHUFFLE(3, 1, 2, 0));
+        v1 = _mm256_shuffle_epi32(v1, _MM_SHUFFLE(3, 1, 2, 0));
+        a = _mm256_unpacklo_epi64(v0, v1);
+        b = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi32(rep2(zetas[k]), rep2(zetas[k - 1]), rep2(zetas[k - 4]), rep2(zetas[k - 5]),
+                              rep2(zetas[k - 2]), rep2(zetas[k - 3]), rep2(zetas[k - 6]), rep2(zetas[k - 7]));
+        INV_BUTTERFLY(a, b, z);
+        _mm256_storeu_si256((__m256i *)&r[start], _mm256_unpacklo_epi32(a, b));
+        _mm256_storeu_si256((__m256i *)&r[start + 16], _mm256_unpackhi_epi32(a, b));
+    }
+
+    /* len = 4, zetas 63 down to 32 */
+    for (start = 0; start < 256; start += 32, k -= 4) {
+        v0 = _mm256_loadu_si256((const __m256i *)&r[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&r[start + 16]);
+        a = _mm256_unpacklo_epi64(v0, v1);
+        b = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi64x(rep4(zetas[k]), rep4(zetas[k - 2]),
+                               rep4(zetas[k - 1]), rep4(zetas[k - 3]));
+        INV_BUTTERFLY(a, b, z);
+        _mm256_storeu_si256((__m256i *)&r[start], _mm256_unpacklo_epi64(a, b));
+        _mm256_storeu_si256((__m256i *)&r[start + 16], _mm256_unpackhi_epi64(a, b));
+    }
+
+    /* len = 8, zetas 31 down to 16 */
+    for (start = 0; start < 256; start += 32, k -= 2) {
+        v0 = _mm256_loadu_si256((const __m256i *)&r[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&r[start + 16]);
+        a = _mm256_permute2x128_si256(v0, v1, 0x20);
+        b = _mm256_permute2x128_si256(v0, v1, 0x31);
+        z = _mm256_setr_m128i(_mm_set1_epi16(zetas[k]), _mm_set1_epi16(zetas[k - 1]));
+        INV_BUTTERFLY(a, b, z);
+        _mm256_storeu_si256((__m256i *)&r[start], _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)&r[start + 16], _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    for (len = 16; len <= 128; len <<= 1) {
+        for (start = 0; start < 256; start += 2 * len) {
+            z = _mm256_set1_epi16(zetas[k--]);
+            for (j = start; j < start + len; j += 16) {
+                a = _mm256_loadu_si256((const __m256i *)&r[j]);
+                b = _mm256_loadu_si256((const __m256i *)&r[j + len]);
+                INV_BUTTERFLY(a, b, z);
+                _mm256_storeu_si256((__m256i *)&r[j], a);
+                _mm256_storeu_si256((__m256i *)&r[j + len], b);
+            }
+        }
+    }
+
+    for (j = 0; j < 256; j += 16) {
+        a = _mm256_loadu_si256((const __m256i *)&r[j]);
+        _mm256_storeu_si256((__m256i *)&r[j], fqmul_x16(a, f));
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_basemul_avx2
+*
+* Description: AVX2 version of the poly_basemul_montgomery loop: all 128
+*              degree-1 products of two polynomials in NTT domain.
+*
+* Arguments:   - int16_t r[256]: pointer to the output polynomial
+*              - const int16_t a[256]: pointer to the first factor
+*              - const int16_t b[256]: pointer to the second factor
+**************************************************/
+AVX2 void PQCLEAN_MLKEM512_CLEAN_basemul_avx2(int16_t r[256], const int16_t a[256], const int16_t b[256]) {
+    const int16_t *zetas = PQCLEAN_MLKEM512_CLEAN_zetas + 64;
+    unsigned int i;
+    __m256i va, vb, vbswap, p, pz, q, z, even, odd;
+
+    /* 16 coefficients = four (a0 + a1 X) pairs with zetas z_i, -z_i, z_i+1, -z_i+1 */
+    for (i = 0; i < 256; i += 16) {
+        const int16_t *zi = &zetas[i / 4];
+        va = _mm256_loadu_si256((const __m256i *)&a[i]);
+        vb = _mm256_loadu_si256((const __m256i *)&b[i]);
+        vbswap = _mm256_or_si256(_mm256_slli_epi32(vb, 16), _mm256_srli_epi32(vb, 16));
+        z = _mm256_setr_epi16(0, zi[0], 0, (int16_t) - zi[0], 0, zi[1], 0, (int16_t) - zi[1],
+                              0, zi[2], 0, (int16_t) - zi[2], 0, zi[3], 0, (int16_t) - zi[3]);
+
+        /* even lanes: a0*b0, odd lanes: a1*b1 (then times zeta) */
+        p = fqmul_x16(va, vb);
+        pz = fqmul_x16(p, z);
+        /* even lanes: a0*b1, odd lanes: a1*b0 */
+        q = fqmul_x16(va, vbswap);
+
+        /* r0 = zeta*a1*b1 + a0*b0 in even lanes, r1 = a0*b1 + a1*b0 in odd lanes */
+        even = _mm256_add_epi16(_mm256_srli_epi32(pz, 16), p);
+        odd = _mm256_add_epi16(_mm256_slli_epi32(q, 16), q);
+        _mm256_storeu_si256((__m256i *)&r[i], _mm256_blend_epi16(even, odd, 0xAA));
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_reduce_avx2
+*
+* Description: AVX2 version of poly_reduce: Barrett reduction of all
+*              coefficients.
+*
+* Arguments:   - int16_t r[256]: pointer to input/output polynomial
+**************************************************/
+AVX2 void PQCLEAN_MLKEM512_CLEAN_reduce_avx2(int16_t r[256]) {
+    unsigned int i;
+
+    for (i = 0; i < 256; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&r[i]);
+        _mm256_storeu_si256((__m256i *)&r[i], barrett_x16(a));
+    }
+}
+
+#else
+/* ISO C forbids an empty translation unit */
+typedef int PQCLEAN_MLKEM512_CLEAN_ntt_avx2_unused;
+#endif
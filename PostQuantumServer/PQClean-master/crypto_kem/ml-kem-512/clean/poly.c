@@ -2,10 +2,15 @@
 #include "ntt.h"
 #include "params.h"
 #include "poly.h"
+#include "pqbench.h"
 #include "reduce.h"
 #include "symmetric.h"
 #include "verify.h"
 #include <stdint.h>
+#include <string.h>
+#ifdef PQCLEAN_USE_KECCAK4X
+#include "fips202x4.h"
+#endif
 
 /*************************************************
 * Name:        PQCLEAN_MLKEM512_CLEAN_poly_compress
@@ -117,6 +122,7 @@ void PQCLEAN_MLKEM512_CLEAN_poly_frombytes(poly *r, const uint8_t a[KYBER_POLYBY
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_frommsg(poly *r, const uint8_t msg[KYBER_INDCPA_MSGBYTES]) {
     size_t i, j;
+    DBENCH_START();
 
     for (i = 0; i < KYBER_N / 8; i++) {
         for (j = 0; j < 8; j++) {
@@ -124,6 +130,7 @@ void PQCLEAN_MLKEM512_CLEAN_poly_frommsg(poly *r, const uint8_t msg[KYBER_INDCPA
             PQCLEAN_MLKEM512_CLEAN_cmov_int16(r->coeffs + 8 * i + j, ((KYBER_Q + 1) / 2), (msg[i] >> j) & 1);
         }
     }
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -137,6 +144,7 @@ void PQCLEAN_MLKEM512_CLEAN_poly_frommsg(poly *r, const uint8_t msg[KYBER_INDCPA
 void PQCLEAN_MLKEM512_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], const poly *a) {
     unsigned int i, j;
     uint32_t t;
+    DBENCH_START();
 
     for (i = 0; i < KYBER_N / 8; i++) {
         msg[i] = 0;
@@ -152,6 +160,7 @@ void PQCLEAN_MLKEM512_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], const
             msg[i] |= t << j;
         }
     }
+    DBENCH_STOP(*tpack);
 }
 
 /*************************************************
@@ -168,8 +177,10 @@ void PQCLEAN_MLKEM512_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], const
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t nonce) {
     uint8_t buf[KYBER_ETA1 * KYBER_N / 4];
+    DBENCH_START();
     prf(buf, sizeof(buf), seed, nonce);
     PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r, buf);
+    DBENCH_STOP(*tsample);
 }
 
 /*************************************************
@@ -186,8 +197,116 @@ void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(poly *r, const uint8_t seed[KYBER
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t nonce) {
     uint8_t buf[KYBER_ETA2 * KYBER_N / 4];
+    DBENCH_START();
     prf(buf, sizeof(buf), seed, nonce);
     PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta2(r, buf);
+    DBENCH_STOP(*tsample);
+}
+
+#ifdef PQCLEAN_USE_KECCAK4X
+#define NOISE_NBLOCKS ((KYBER_ETA1 * KYBER_N / 4 + SHAKE256_RATE - 1) / SHAKE256_RATE)
+
+/*************************************************
+* Name:        prf_x4
+*
+* Description: Four PRF calls with one key and different nonces, computed
+*              with the 4-way Keccak. buf[j] equals the first bytes of
+*              prf(seed, nonce[j]).
+*
+* Arguments:   - uint8_t buf[4][...]: output streams
+*              - const uint8_t *seed: pointer to input seed
+*                                     (of length KYBER_SYMBYTES bytes)
+*              - const uint8_t *nonce: four one-byte nonces
+**************************************************/
+static void prf_x4(uint8_t buf[4][NOISE_NBLOCKS * SHAKE256_RATE],
+                   const uint8_t seed[KYBER_SYMBYTES],
+                   const uint8_t nonce[4]) {
+    uint8_t extkey[4][KYBER_SYMBYTES + 1];
+    keccakx4_state state;
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(extkey[j], seed, KYBER_SYMBYTES);
+        extkey[j][KYBER_SYMBYTES] = nonce[j];
+    }
+    shake256x4_absorb_once(&state, extkey[0], extkey[1], extkey[2], extkey[3], KYBER_SYMBYTES + 1);
+    shake256x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], NOISE_NBLOCKS, &state);
+}
+#endif
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1_4x
+*
+* Description: Four calls of poly_getnoise_eta1 with the same seed, run as
+*              four parallel SHAKE256 streams when the 4-way Keccak is built
+*              and the CPU supports AVX2
+*
+* Arguments:   - poly *r0, *r1, *r2, *r3: pointers to output polynomials
+*              - const uint8_t *seed: pointer to input seed
+*                                     (of length KYBER_SYMBYTES bytes)
+*              - uint8_t nonce0..nonce3: one-byte input nonces
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1_4x(poly *r0, poly *r1, poly *r2, poly *r3,
+        const uint8_t seed[KYBER_SYMBYTES],
+        uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3) {
+#ifdef PQCLEAN_USE_KECCAK4X
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        uint8_t buf[4][NOISE_NBLOCKS * SHAKE256_RATE];
+        const uint8_t nonce[4] = {nonce0, nonce1, nonce2, nonce3};
+        DBENCH_START();
+
+        prf_x4(buf, seed, nonce);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r0, buf[0]);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r1, buf[1]);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r2, buf[2]);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r3, buf[3]);
+        DBENCH_STOP(*tsample);
+        return;
+    }
+#endif
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(r0, seed, nonce0);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(r1, seed, nonce1);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(r2, seed, nonce2);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(r3, seed, nonce3);
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1122_4x
+*
+* Description: Two calls of poly_getnoise_eta1 followed by two calls of
+*              poly_getnoise_eta2 with the same seed, run as four parallel
+*              SHAKE256 streams when the 4-way Keccak is built and the CPU
+*              supports AVX2
+*
+* Arguments:   - poly *r0, *r1: pointers to output polynomials (eta1)
+*              - poly *r2, *r3: pointers to output polynomials (eta2)
+*              - const uint8_t *seed: pointer to input seed
+*                                     (of length KYBER_SYMBYTES bytes)
+*              - uint8_t nonce0..nonce3: one-byte input nonces
+**************************************************/
+void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1122_4x(poly *r0, poly *r1, poly *r2, poly *r3,
+        const uint8_t seed[KYBER_SYMBYTES],
+        uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3) {
+#ifdef PQCLEAN_USE_KECCAK4X
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        uint8_t buf[4][NOISE_NBLOCKS * SHAKE256_RATE];
+        const uint8_t nonce[4] = {nonce0, nonce1, nonce2, nonce3};
+        DBENCH_START();
+
+        /* eta2 needs fewer bytes: SHAKE output is a prefix of the longer stream */
+        prf_x4(buf, seed, nonce);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r0, buf[0]);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta1(r1, buf[1]);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta2(r2, buf[2]);
+        PQCLEAN_MLKEM512_CLEAN_poly_cbd_eta2(r3, buf[3]);
+        DBENCH_STOP(*tsample);
+        return;
+    }
+#endif
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(r0, seed, nonce0);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(r1, seed, nonce1);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(r2, seed, nonce2);
+    PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(r3, seed, nonce3);
 }
 
 
@@ -201,8 +320,18 @@ void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER
 * Arguments:   - uint16_t *r: pointer to in/output polynomial
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_ntt(poly *r) {
+    DBENCH_START();
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        PQCLEAN_MLKEM512_CLEAN_ntt_avx2(r->coeffs);
+        PQCLEAN_MLKEM512_CLEAN_reduce_avx2(r->coeffs);
+        DBENCH_STOP(*tmul);
+        return;
+    }
+#endif
     PQCLEAN_MLKEM512_CLEAN_ntt(r->coeffs);
     PQCLEAN_MLKEM512_CLEAN_poly_reduce(r);
+    DBENCH_STOP(*tmul);
 }
 
 /*************************************************
@@ -215,7 +344,16 @@ void PQCLEAN_MLKEM512_CLEAN_poly_ntt(poly *r) {
 * Arguments:   - uint16_t *a: pointer to in/output polynomial
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_invntt_tomont(poly *r) {
+    DBENCH_START();
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        PQCLEAN_MLKEM512_CLEAN_invntt_avx2(r->coeffs);
+        DBENCH_STOP(*tmul);
+        return;
+    }
+#endif
     PQCLEAN_MLKEM512_CLEAN_invntt(r->coeffs);
+    DBENCH_STOP(*tmul);
 }
 
 /*************************************************
@@ -229,10 +367,19 @@ void PQCLEAN_MLKEM512_CLEAN_poly_invntt_tomont(poly *r) {
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_basemul_montgomery(poly *r, const poly *a, const poly *b) {
     size_t i;
+    DBENCH_START();
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        PQCLEAN_MLKEM512_CLEAN_basemul_avx2(r->coeffs, a->coeffs, b->coeffs);
+        DBENCH_STOP(*tmul);
+        return;
+    }
+#endif
     for (i = 0; i < KYBER_N / 4; i++) {
         PQCLEAN_MLKEM512_CLEAN_basemul(&r->coeffs[4 * i], &a->coeffs[4 * i], &b->coeffs[4 * i], PQCLEAN_MLKEM512_CLEAN_zetas[64 + i]);
         PQCLEAN_MLKEM512_CLEAN_basemul(&r->coeffs[4 * i + 2], &a->coeffs[4 * i + 2], &b->coeffs[4 * i + 2], -PQCLEAN_MLKEM512_CLEAN_zetas[64 + i]);
     }
+    DBENCH_STOP(*tmul);
 }
 
 /*************************************************
@@ -261,6 +408,12 @@ void PQCLEAN_MLKEM512_CLEAN_poly_tomont(poly *r) {
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_poly_reduce(poly *r) {
     size_t i;
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        PQCLEAN_MLKEM512_CLEAN_reduce_avx2(r->coeffs);
+        return;
+    }
+#endif
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = PQCLEAN_MLKEM512_CLEAN_barrett_reduce(r->coeffs[i]);
     }
@@ -24,6 +24,14 @@ void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1(poly *r, const uint8_t seed[KYBER
 
 void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t nonce);
 
+void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1_4x(poly *r0, poly *r1, poly *r2, poly *r3,
+        const uint8_t seed[KYBER_SYMBYTES],
+        uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3);
+
+void PQCLEAN_MLKEM512_CLEAN_poly_getnoise_eta1122_4x(poly *r0, poly *r1, poly *r2, poly *r3,
+        const uint8_t seed[KYBER_SYMBYTES],
+        uint8_t nonce0, uint8_t nonce1, uint8_t nonce2, uint8_t nonce3);
+
 void PQCLEAN_MLKEM512_CLEAN_poly_ntt(poly *r);
 void PQCLEAN_MLKEM512_CLEAN_poly_invntt_tomont(poly *r);
 void PQCLEAN_MLKEM512_CLEAN_poly_basemul_montgomery(poly *r, const poly *a, const poly *b);
@@ -0,0 +1,21 @@
+#ifndef PQCLEAN_MLKEM512_CLEAN_REJSAMPLE_H
+#define PQCLEAN_MLKEM512_CLEAN_REJSAMPLE_H
+#include "ntt.h"
+#include "params.h"
+#include <stdint.h>
+
+/* Portable sampler (indcpa.c) */
+unsigned int PQCLEAN_MLKEM512_CLEAN_rej_uniform(int16_t *r,
+        unsigned int len,
+        const uint8_t *buf,
+        unsigned int buflen);
+
+/* AVX2 sampler (rejsample_avx2.c), available together with the AVX2 NTT */
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+unsigned int PQCLEAN_MLKEM512_CLEAN_rej_uniform_avx2(int16_t *r,
+        unsigned int len,
+        const uint8_t *buf,
+        unsigned int buflen);
+#endif
+
+#endif
@@ -25,7 +25,7 @@ void PQCLEAN_MLKEM512_CLEAN_kyber_shake128_absorb(xof_state *state,
     extseed[KYBER_SYMBYTES + 0] = x;
     extseed[KYBER_SYMBYTES + 1] = y;
 
-    shake128_absorb(state, extseed, sizeof(extseed));
+    shake128_state_absorb(state, extseed, sizeof(extseed));
 }
 
 /*************************************************
@@ -60,12 +60,11 @@ void PQCLEAN_MLKEM512_CLEAN_kyber_shake256_prf(uint8_t *out, size_t outlen, cons
 *              - uint8_t nonce: single-byte nonce (public PRF input)
 **************************************************/
 void PQCLEAN_MLKEM512_CLEAN_kyber_shake256_rkprf(uint8_t out[KYBER_SSBYTES], const uint8_t key[KYBER_SYMBYTES], const uint8_t input[KYBER_CIPHERTEXTBYTES]) {
-    shake256incctx s;
+    shake256incstate s;
 
-    shake256_inc_init(&s);
-    shake256_inc_absorb(&s, key, KYBER_SYMBYTES);
-    shake256_inc_absorb(&s, input, KYBER_CIPHERTEXTBYTES);
-    shake256_inc_finalize(&s);
-    shake256_inc_squeeze(out, KYBER_SSBYTES, &s);
-    shake256_inc_ctx_release(&s);
+    shake256_inc_state_init(&s);
+    shake256_inc_state_absorb(&s, key, KYBER_SYMBYTES);
+    shake256_inc_state_absorb(&s, input, KYBER_CIPHERTEXTBYTES);
+    shake256_inc_state_finalize(&s);
+    shake256_inc_state_squeeze(out, KYBER_SSBYTES, &s);
 }
@@ -1,6 +1,7 @@
 #ifndef PQCLEAN_MLDSA44_CLEAN_API_H
 #define PQCLEAN_MLDSA44_CLEAN_API_H
 
+#include "fips202.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -9,6 +10,26 @@
 #define PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES 2420
 #define PQCLEAN_MLDSA44_CLEAN_CRYPTO_ALGNAME "ML-DSA-44"
 
+/* Secret key prepared for repeated signing (see crypto_sign_signer_new) */
+#ifndef PQCLEAN_MLDSA44_CLEAN_SIGNER_T
+#define PQCLEAN_MLDSA44_CLEAN_SIGNER_T
+typedef struct PQCLEAN_MLDSA44_CLEAN_signer PQCLEAN_MLDSA44_CLEAN_signer;
+#endif
+
+/* Public key prepared for repeated verification (see crypto_sign_verifier_new) */
+#ifndef PQCLEAN_MLDSA44_CLEAN_VERIFIER_T
+#define PQCLEAN_MLDSA44_CLEAN_VERIFIER_T
+typedef struct PQCLEAN_MLDSA44_CLEAN_verifier PQCLEAN_MLDSA44_CLEAN_verifier;
+#endif
+
+/* Message hash (mu) state of a streaming signature or verification */
+#ifndef PQCLEAN_MLDSA44_CLEAN_SIGN_STREAM_T
+#define PQCLEAN_MLDSA44_CLEAN_SIGN_STREAM_T
+typedef struct {
+    shake256incstate state;
+} PQCLEAN_MLDSA44_CLEAN_sign_stream;
+#endif
+
 int PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
 
 int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(uint8_t *sig, size_t *siglen,
@@ -47,4 +68,48 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_open(uint8_t *m, size_t *mlen,
         const uint8_t *sm, size_t smlen,
         const uint8_t *pk);
 
+PQCLEAN_MLDSA44_CLEAN_signer *PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_new(const uint8_t *sk);
+
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free(PQCLEAN_MLDSA44_CLEAN_signer *signer);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_signer(uint8_t *sig, size_t *siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const PQCLEAN_MLDSA44_CLEAN_signer *signer);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_batch(uint8_t *sigs, size_t *siglens,
+        const uint8_t *const *m, const size_t *mlen,
+        size_t count, const PQCLEAN_MLDSA44_CLEAN_signer *signer);
+
+PQCLEAN_MLDSA44_CLEAN_verifier *PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_new(const uint8_t *pk);
+
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free(PQCLEAN_MLDSA44_CLEAN_verifier *verifier);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_verifier(const uint8_t *sig, size_t siglen,
+        const uint8_t *m, size_t mlen,
+        const uint8_t *ctx, size_t ctxlen,
+        const PQCLEAN_MLDSA44_CLEAN_verifier *verifier);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_batch(const uint8_t *sigs, const size_t *siglens,
+        const uint8_t *const *m, const size_t *mlen,
+        size_t count, uint8_t *ok, const PQCLEAN_MLDSA44_CLEAN_verifier *verifier);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_init(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_update(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *m, size_t mlen);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_final(uint8_t *sig, size_t *siglen,
+        PQCLEAN_MLDSA44_CLEAN_sign_stream *stream, const uint8_t *sk);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_init(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
+
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_update(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *m, size_t mlen);
+
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_final(const uint8_t *sig, size_t siglen,
+        PQCLEAN_MLDSA44_CLEAN_sign_stream *stream, const uint8_t *pk);
+
 #endif
@@ -3,7 +3,7 @@
 #include "reduce.h"
 #include <stdint.h>
 
-static const int32_t zetas[N] = {
+const int32_t PQCLEAN_MLDSA44_CLEAN_zetas[N] = {
     0,    25847, -2608894, -518909,   237124, -777960, -876248,   466468,
     1826347,  2353451, -359251, -2091905,  3119733, -2884855,  3111497,  2680103,
     2725464,  1024112, -1079900,  3585928, -549488, -1119584,  2619752, -2108549,
@@ -53,7 +53,7 @@ void PQCLEAN_MLDSA44_CLEAN_ntt(int32_t a[N]) {
     k = 0;
     for (len = 128; len > 0; len >>= 1) {
         for (start = 0; start < N; start = j + len) {
-            zeta = zetas[++k];
+            zeta = PQCLEAN_MLDSA44_CLEAN_zetas[++k];
             for (j = start; j < start + len; ++j) {
                 t = PQCLEAN_MLDSA44_CLEAN_montgomery_reduce((int64_t)zeta * a[j + len]);
                 a[j + len] = a[j] - t;
@@ -82,7 +82,7 @@ void PQCLEAN_MLDSA44_CLEAN_invntt_tomont(int32_t a[N]) {
     k = 256;
     for (len = 1; len < N; len <<= 1) {
         for (start = 0; start < N; start = j + len) {
-            zeta = -zetas[--k];
+            zeta = -PQCLEAN_MLDSA44_CLEAN_zetas[--k];
             for (j = start; j < start + len; ++j) {
                 t = a[j];
                 a[j] = t + a[j + len];
@@ -3,8 +3,23 @@
 #include "params.h"
 #include <stdint.h>
 
+extern const int32_t PQCLEAN_MLDSA44_CLEAN_zetas[N];
+
 void PQCLEAN_MLDSA44_CLEAN_ntt(int32_t a[N]);
 
 void PQCLEAN_MLDSA44_CLEAN_invntt_tomont(int32_t a[N]);
 
+/* AVX2 kernels (ntt_avx2.c), used when the CPU reports AVX2 at runtime */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(PQCLEAN_NO_AVX2)
+#define PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+
+int PQCLEAN_MLDSA44_CLEAN_avx2_available(void);
+
+void PQCLEAN_MLDSA44_CLEAN_ntt_avx2(int32_t a[N]);
+
+void PQCLEAN_MLDSA44_CLEAN_invntt_tomont_avx2(int32_t a[N]);
+
+void PQCLEAN_MLDSA44_CLEAN_pointwise_montgomery_avx2(int32_t c[N], const int32_t a[N], const int32_t b[N]);
+#endif
+
 #endif
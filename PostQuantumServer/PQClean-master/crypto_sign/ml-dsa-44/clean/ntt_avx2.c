@@ -0,0 +1,240 @@
+#include "ntt.h"
+#include "params.h"
+#include "reduce.h"
+#include <stdint.h>
+
+/*
+ * AVX2 versions of the NTT, inverse NTT and pointwise multiplication,
+ * 8 coefficients per instruction. Montgomery reductions use the 32x32->64
+ * bit multiplier on the even and odd lanes separately and keep the high
+ * halves, which is exactly what montgomery_reduce() computes, and the
+ * coefficients stay in the clean order. Results are therefore identical to
+ * ntt.c. The functions are compiled for AVX2 via a target attribute and
+ * are only called when PQCLEAN_MLDSA44_CLEAN_avx2_available() says the CPU
+ * supports them.
+ */
+
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA44_CLEAN_avx2_available
+*
+* Description: Runtime CPUID check for AVX2.
+*
+* Returns 1 if the AVX2 kernels may be used, 0 otherwise
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_avx2_available(void) {
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+}
+
+/* montgomery_reduce((int64_t)a*b) in each of the 8 lanes */
+AVX2 static inline __m256i montmul_x8(__m256i a, __m256i b) {
+    const __m256i q = _mm256_set1_epi32(Q);
+    const __m256i qinv = _mm256_set1_epi32(QINV);
+    __m256i pe, po, te, to;
+
+    /* 64-bit products of the even and odd lanes */
+    pe = _mm256_mul_epi32(a, b);
+    po = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+    /* t = (int32_t)(p * QINV); low 32 bits of p - t*Q are zero */
+    te = _mm256_mul_epi32(_mm256_mul_epi32(pe, qinv), q);
+    to = _mm256_mul_epi32(_mm256_mul_epi32(po, qinv), q);
+    pe = _mm256_sub_epi64(pe, te);
+    po = _mm256_sub_epi64(po, to);
+
+    /* (p - t*Q) >> 32: high halves back into their lanes */
+    return _mm256_blend_epi32(_mm256_srli_epi64(pe, 32), po, 0xAA);
+}
+
+/* Forward butterfly: (a, b) -> (a + zeta*b, a - zeta*b) */
+#define FWD_BUTTERFLY(A, B, Z) do {              \
+        __m256i t_ = montmul_x8((Z), (B));       \
+        (B) = _mm256_sub_epi32((A), t_);         \
+        (A) = _mm256_add_epi32((A), t_);         \
+    } while (0)
+
+/* Inverse butterfly: (a, b) -> (a + b, zeta*(a - b)) */
+#define INV_BUTTERFLY(A, B, Z) do {              \
+        __m256i t_ = (A);                        \
+        (A) = _mm256_add_epi32(t_, (B));         \
+        (B) = montmul_x8((Z), _mm256_sub_epi32(t_, (B))); \
+    } while (0)
+
+/*
+ * Layers with len >= 8 work on whole vectors. The three short layers work
+ * on two vectors (16 coefficients) at a time and first gather the "low"
+ * halves of all butterflies into one vector and the "high" halves into the
+ * other:
+ *   len 4: 128-bit halves  (permute2x128)
+ *   len 2: 64-bit quarters (unpack epi64)
+ *   len 1: single lanes    (shuffle epi32 + unpack epi64)
+ */
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA44_CLEAN_ntt_avx2
+*
+* Description: AVX2 version of PQCLEAN_MLDSA44_CLEAN_ntt.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+AVX2 void PQCLEAN_MLDSA44_CLEAN_ntt_avx2(int32_t a[N]) {
+    const int32_t *zetas = PQCLEAN_MLDSA44_CLEAN_zetas;
+    unsigned int len, start, j, k;
+    __m256i x, y, z, v0, v1;
+
+    k = 0;
+    for (len = 128; len >= 8; len >>= 1) {
+        for (start = 0; start < N; start += 2 * len) {
+            z = _mm256_set1_epi32(zetas[++k]);
+            for (j = start; j < start + len; j += 8) {
+                x = _mm256_loadu_si256((const __m256i *)&a[j]);
+                y = _mm256_loadu_si256((const __m256i *)&a[j + len]);
+                FWD_BUTTERFLY(x, y, z);
+                _mm256_storeu_si256((__m256i *)&a[j], x);
+                _mm256_storeu_si256((__m256i *)&a[j + len], y);
+            }
+        }
+    }
+
+    /* len = 4, zetas 32..63, two groups per 16 coefficients */
+    for (start = 0; start < N; start += 16, k += 2) {
+        v0 = _mm256_loadu_si256((const __m256i *)&a[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&a[start + 8]);
+        x = _mm256_permute2x128_si256(v0, v1, 0x20);
+        y = _mm256_permute2x128_si256(v0, v1, 0x31);
+        z = _mm256_setr_m128i(_mm_set1_epi32(zetas[k + 1]), _mm_set1_epi32(zetas[k + 2]));
+        FWD_BUTTERFLY(x, y, z);
+        _mm256_storeu_si256((__m256i *)&a[start], _mm256_permute2x128_si256(x, y, 0x20));
+        _mm256_storeu_si256((__m256i *)&a[start + 8], _mm256_permute2x128_si256(x, y, 0x31));
+    }
+
+    /* len = 2, zetas 64..127, four groups per 16 coefficients */
+    for (start = 0; start < N; start += 16, k += 4) {
+        v0 = _mm256_loadu_si256((const __m256i *)&a[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&a[start + 8]);
+        x = _mm256_unpacklo_epi64(v0, v1);
+        y = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi32(zetas[k + 1], zetas[k + 1], zetas[k + 3], zetas[k + 3],
+                              zetas[k + 2], zetas[k + 2], zetas[k + 4], zetas[k + 4]);
+        FWD_BUTTERFLY(x, y, z);
+        _mm256_storeu_si256((__m256i *)&a[start], _mm256_unpacklo_epi64(x, y));
+        _mm256_storeu_si256((__m256i *)&a[start + 8], _mm256_unpackhi_epi64(x, y));
+    }
+
+    /* len = 1, zetas 128..255, eight groups per 16 coefficients */
+    for (start = 0; start < N; start += 16, k += 8) {
+        v0 = _mm256_loadu_si256((const __m256i *)&a[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&a[start + 8]);
+        v0 = _mm256_shuffle_epi32(v0, _MM_SHUFFLE(3, 1, 2, 0));
+        v1 = _mm256_shuffle_epi32(v1, _MM_SHUFFLE(3, 1, 2, 0));
+        x = _mm256_unpacklo_epi64(v0, v1);
+        y = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi32(zetas[k + 1], zetas[k + 2], zetas[k + 5], zetas[k + 6],
+                              zetas[k + 3], zetas[k + 4], zetas[k + 7], zetas[k + 8]);
+        FWD_BUTTERFLY(x, y, z);
+        _mm256_storeu_si256((__m256i *)&a[start], _mm256_unpacklo_epi32(x, y));
+        _mm256_storeu_si256((__m256i *)&a[start + 8], _mm256_unpackhi_epi32(x, y));
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA44_CLEAN_invntt_tomont_avx2
+*
+* Description: AVX2 version of PQCLEAN_MLDSA44_CLEAN_invntt_tomont.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+AVX2 void PQCLEAN_MLDSA44_CLEAN_invntt_tomont_avx2(int32_t a[N]) {
+    const int32_t *zetas = PQCLEAN_MLDSA44_CLEAN_zetas;
+    const __m256i f = _mm256_set1_epi32(41978); // mont^2/256
+    unsigned int len, start, j, k;
+    __m256i x, y, z, v0, v1;
+
+    /* len = 1, zetas 255 down to 128 */
+    k = 256;
+    for (start = 0; start < N; start += 16, k -= 8) {
+        v0 = _mm256_loadu_si256((const __m256i *)&a[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&a[start + 8]);
+        v0 = _mm256_shuffle_epi32(v0, _MM_SHUFFLE(3, 1, 2, 0));
+        v1 = _mm256_shuffle_epi32(v1, _MM_SHUFFLE(3, 1, 2, 0));
+        x = _mm256_unpacklo_epi64(v0, v1);
+        y = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi32(-zetas[k - 1], -zetas[k - 2], -zetas[k - 5], -zetas[k - 6],
+                              -zetas[k - 3], -zetas[k - 4], -zetas[k - 7], -zetas[k - 8]);
+        INV_BUTTERFLY(x, y, z);
+        _mm256_storeu_si256((__m256i *)&a[start], _mm256_unpacklo_epi32(x, y));
+        _mm256_storeu_si256((__m256i *)&a[start + 8], _mm256_unpackhi_epi32(x, y));
+    }
+
+    /* len = 2, zetas 127 down to 64 */
+    for (start = 0; start < N; start += 16, k -= 4) {
+        v0 = _mm256_loadu_si256((const __m256i *)&a[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&a[start + 8]);
+        x = _mm256_unpacklo_epi64(v0, v1);
+        y = _mm256_unpackhi_epi64(v0, v1);
+        z = _mm256_setr_epi32(-zetas[k - 1], -zetas[k - 1], -zetas[k - 3], -zetas[k - 3],
+                              -zetas[k - 2], -zetas[k - 2], -zetas[k - 4], -zetas[k - 4]);
+        INV_BUTTERFLY(x, y, z);
+        _mm256_storeu_si256((__m256i *)&a[start], _mm256_unpacklo_epi64(x, y));
+        _mm256_storeu_si256((__m256i *)&a[start + 8], _mm256_unpackhi_epi64(x, y));
+    }
+
+    /* len = 4, zetas 63 down to 32 */
+    for (start = 0; start < N; start += 16, k -= 2) {
+        v0 = _mm256_loadu_si256((const __m256i *)&a[start]);
+        v1 = _mm256_loadu_si256((const __m256i *)&a[start + 8]);
+        x = _mm256_permute2x128_si256(v0, v1, 0x20);
+        y = _mm256_permute2x128_si256(v0, v1, 0x31);
+        z = _mm256_setr_m128i(_mm_set1_epi32(-zetas[k - 1]), _mm_set1_epi32(-zetas[k - 2]));
+        INV_BUTTERFLY(x, y, z);
+        _mm256_storeu_si256((__m256i *)&a[start], _mm256_permute2x128_si256(x, y, 0x20));
+        _mm256_storeu_si256((__m256i *)&a[start + 8], _mm256_permute2x128_si256(x, y, 0x31));
+    }
+
+    for (len = 8; len < N; len <<= 1) {
+        for (start = 0; start < N; start += 2 * len) {
+            z = _mm256_set1_epi32(-zetas[--k]);
+            for (j = start; j < start + len; j += 8) {
+                x = _mm256_loadu_si256((const __m256i *)&a[j]);
+                y = _mm256_loadu_si256((const __m256i *)&a[j + len]);
+                INV_BUTTERFLY(x, y, z);
+                _mm256_storeu_si256((__m256i *)&a[j], x);
+                _mm256_storeu_si256((__m256i *)&a[j + len], y);
+            }
+        }
+    }
+
+    for (j = 0; j < N; j += 8) {
+        x = _mm256_loadu_si256((const __m256i *)&a[j]);
+        _mm256_storeu_si256((__m256i *)&a[j], montmul_x8(f, x));
+    }
+}
+
+/*************************************************
+* Name:        PQCLEAN_MLDSA44_CLEAN_pointwise_montgomery_avx2
+*
+* Description: AVX2 version of the poly_pointwise_montgomery loop.
+*
+* Arguments:   - int32_t c[N]: output coefficient array
+*              - const int32_t a[N]: first input coefficient array
+*              - const int32_t b[N]: second input coefficient array
+**************************************************/
+AVX2 void PQCLEAN_MLDSA44_CLEAN_pointwise_montgomery_avx2(int32_t c[N], const int32_t a[N], const int32_t b[N]) {
+    unsigned int i;
+
+    for (i = 0; i < N; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)&a[i]);
+        __m256i y = _mm256_loadu_si256((const __m256i *)&b[i]);
+        _mm256_storeu_si256((__m256i *)&c[i], montmul_x8(x, y));
+    }
+}
+
+#else
+/* ISO C forbids an empty translation unit */
+typedef int PQCLEAN_MLDSA44_CLEAN_ntt_avx2_unused;
+#endif
@@ -2,12 +2,14 @@
 #include "params.h"
 #include "poly.h"
 #include "reduce.h"
+#include "rejsample.h"
 #include "rounding.h"
 #include "symmetric.h"
 #include <stdint.h>
-
-#define DBENCH_START()
-#define DBENCH_STOP(t)
+#ifdef PQCLEAN_USE_KECCAK4X
+#include "fips202x4.h"
+#endif
+#include "pqbench.h"
 
 /*************************************************
 * Name:        PQCLEAN_MLDSA44_CLEAN_poly_reduce
@@ -119,6 +121,13 @@ void PQCLEAN_MLDSA44_CLEAN_poly_shiftl(poly *a) {
 void PQCLEAN_MLDSA44_CLEAN_poly_ntt(poly *a) {
     DBENCH_START();
 
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLDSA44_CLEAN_avx2_available()) {
+        PQCLEAN_MLDSA44_CLEAN_ntt_avx2(a->coeffs);
+        DBENCH_STOP(*tmul);
+        return;
+    }
+#endif
     PQCLEAN_MLDSA44_CLEAN_ntt(a->coeffs);
 
     DBENCH_STOP(*tmul);
@@ -136,6 +145,13 @@ void PQCLEAN_MLDSA44_CLEAN_poly_ntt(poly *a) {
 void PQCLEAN_MLDSA44_CLEAN_poly_invntt_tomont(poly *a) {
     DBENCH_START();
 
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLDSA44_CLEAN_avx2_available()) {
+        PQCLEAN_MLDSA44_CLEAN_invntt_tomont_avx2(a->coeffs);
+        DBENCH_STOP(*tmul);
+        return;
+    }
+#endif
     PQCLEAN_MLDSA44_CLEAN_invntt_tomont(a->coeffs);
 
     DBENCH_STOP(*tmul);
@@ -156,6 +172,13 @@ void PQCLEAN_MLDSA44_CLEAN_poly_pointwise_montgomery(poly *c, const poly *a, con
     unsigned int i;
     DBENCH_START();
 
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLDSA44_CLEAN_avx2_available()) {
+        PQCLEAN_MLDSA44_CLEAN_pointwise_montgomery_avx2(c->coeffs, a->coeffs, b->coeffs);
+        DBENCH_STOP(*tmul);
+        return;
+    }
+#endif
     for (i = 0; i < N; ++i) {
         c->coeffs[i] = PQCLEAN_MLDSA44_CLEAN_montgomery_reduce((int64_t)a->coeffs[i] * b->coeffs[i]);
     }
@@ -295,10 +318,11 @@ int PQCLEAN_MLDSA44_CLEAN_poly_chknorm(const poly *a, int32_t B) {
 }
 
 /*************************************************
-* Name:        rej_uniform
+* Name:        PQCLEAN_MLDSA44_CLEAN_rej_uniform
 *
 * Description: Sample uniformly random coefficients in [0, Q-1] by
-*              performing rejection sampling on array of random bytes.
+*              performing rejection sampling on array of random bytes
+*              (portable C; the reference for the AVX2 sampler).
 *
 * Arguments:   - int32_t *a: pointer to output array (allocated)
 *              - unsigned int len: number of coefficients to be sampled
@@ -308,13 +332,12 @@ int PQCLEAN_MLDSA44_CLEAN_poly_chknorm(const poly *a, int32_t B) {
 * Returns number of sampled coefficients. Can be smaller than len if not enough
 * random bytes were given.
 **************************************************/
-static unsigned int rej_uniform(int32_t *a,
-                                unsigned int len,
-                                const uint8_t *buf,
-                                unsigned int buflen) {
+unsigned int PQCLEAN_MLDSA44_CLEAN_rej_uniform(int32_t *a,
+        unsigned int len,
+        const uint8_t *buf,
+        unsigned int buflen) {
     unsigned int ctr, pos;
     uint32_t t;
-    DBENCH_START();
 
     ctr = pos = 0;
     while (ctr < len && pos + 3 <= buflen) {
@@ -328,7 +351,27 @@ static unsigned int rej_uniform(int32_t *a,
         }
     }
 
-    DBENCH_STOP(*tsample);
+    return ctr;
+}
+
+/* Rejection sampling with the AVX2 sampler when the CPU supports it */
+static unsigned int rej_uniform(int32_t *a,
+                                unsigned int len,
+                                const uint8_t *buf,
+                                unsigned int buflen) {
+    unsigned int ctr;
+    DBENCH_START();
+
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+    if (PQCLEAN_MLDSA44_CLEAN_avx2_available()) {
+        ctr = PQCLEAN_MLDSA44_CLEAN_rej_uniform_avx2(a, len, buf, buflen);
+        DBENCH_STOP(*tmatrix);
+        return ctr;
+    }
+#endif
+    ctr = PQCLEAN_MLDSA44_CLEAN_rej_uniform(a, len, buf, buflen);
+
+    DBENCH_STOP(*tmatrix);
     return ctr;
 }
 
@@ -367,7 +410,86 @@ void PQCLEAN_MLDSA44_CLEAN_poly_uniform(poly *a,
         buflen = STREAM128_BLOCKBYTES + off;
         ctr += rej_uniform(a->coeffs + ctr, N - ctr, buf, buflen);
     }
-    stream128_release(&state);
+}
+
+#ifdef PQCLEAN_USE_KECCAK4X
+/*************************************************
+* Name:        poly_uniform_x4
+*
+* Description: Samples four polynomials with four parallel SHAKE128
+*              streams; every output equals its serially sampled version.
+*              Needs AVX2.
+*
+* Arguments:   - poly **a: four output polynomials
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - const uint16_t *nonce: four 2-byte nonces
+**************************************************/
+static void poly_uniform_x4(poly *a[4], const uint8_t seed[SEEDBYTES], const uint16_t nonce[4]) {
+    unsigned int i, j, off;
+    unsigned int ctr[4];
+    unsigned int buflen = POLY_UNIFORM_NBLOCKS * STREAM128_BLOCKBYTES;
+    uint8_t buf[4][POLY_UNIFORM_NBLOCKS * STREAM128_BLOCKBYTES + 2];
+    uint8_t extseed[4][SEEDBYTES + 2];
+    keccakx4_state state;
+
+    for (j = 0; j < 4; ++j) {
+        for (i = 0; i < SEEDBYTES; ++i) {
+            extseed[j][i] = seed[i];
+        }
+        extseed[j][SEEDBYTES + 0] = (uint8_t) nonce[j];
+        extseed[j][SEEDBYTES + 1] = (uint8_t) (nonce[j] >> 8);
+    }
+    shake128x4_absorb_once(&state, extseed[0], extseed[1], extseed[2], extseed[3], SEEDBYTES + 2);
+    shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], POLY_UNIFORM_NBLOCKS, &state);
+
+    for (j = 0; j < 4; ++j) {
+        ctr[j] = rej_uniform(a[j]->coeffs, N, buf[j], buflen);
+    }
+
+    while (ctr[0] < N || ctr[1] < N || ctr[2] < N || ctr[3] < N) {
+        off = buflen % 3;
+        for (j = 0; j < 4; ++j) {
+            for (i = 0; i < off; ++i) {
+                buf[j][i] = buf[j][buflen - off + i];
+            }
+        }
+
+        shake128x4_squeezeblocks(buf[0] + off, buf[1] + off, buf[2] + off, buf[3] + off, 1, &state);
+        buflen = STREAM128_BLOCKBYTES + off;
+        for (j = 0; j < 4; ++j) {
+            ctr[j] += rej_uniform(a[j]->coeffs + ctr[j], N - ctr[j], buf[j], buflen);
+        }
+    }
+}
+#endif
+
+/*************************************************
+* Name:        poly_uniform_4x
+*
+* Description: Four calls of poly_uniform with the same seed. Runs the four
+*              SHAKE128 streams in parallel when the 4-way Keccak is built
+*              and the CPU supports AVX2; every output equals its serially
+*              sampled version.
+*
+* Arguments:   - poly *a0, *a1, *a2, *a3: pointers to output polynomials
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - uint16_t nonce0..nonce3: 2-byte nonces
+**************************************************/
+void PQCLEAN_MLDSA44_CLEAN_poly_uniform_4x(poly *a0, poly *a1, poly *a2, poly *a3,
+        const uint8_t seed[SEEDBYTES],
+        uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+#ifdef PQCLEAN_USE_KECCAK4X
+    if (PQCLEAN_MLDSA44_CLEAN_avx2_available()) {
+        poly *a[4] = {a0, a1, a2, a3};
+        const uint16_t nonce[4] = {nonce0, nonce1, nonce2, nonce3};
+        poly_uniform_x4(a, seed, nonce);
+        return;
+    }
+#endif
+    PQCLEAN_MLDSA44_CLEAN_poly_uniform(a0, seed, nonce0);
+    PQCLEAN_MLDSA44_CLEAN_poly_uniform(a1, seed, nonce1);
+    PQCLEAN_MLDSA44_CLEAN_poly_uniform(a2, seed, nonce2);
+    PQCLEAN_MLDSA44_CLEAN_poly_uniform(a3, seed, nonce3);
 }
 
 /*************************************************
@@ -440,7 +562,6 @@ void PQCLEAN_MLDSA44_CLEAN_poly_uniform_eta(poly *a,
         stream256_squeezeblocks(buf, 1, &state);
         ctr += rej_eta(a->coeffs + ctr, N - ctr, buf, STREAM256_BLOCKBYTES);
     }
-    stream256_release(&state);
 }
 
 /*************************************************
@@ -463,7 +584,6 @@ void PQCLEAN_MLDSA44_CLEAN_poly_uniform_gamma1(poly *a,
 
     stream256_init(&state, seed, nonce);
     stream256_squeezeblocks(buf, POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
-    stream256_release(&state);
     PQCLEAN_MLDSA44_CLEAN_polyz_unpack(a, buf);
 }
 
@@ -481,12 +601,13 @@ void PQCLEAN_MLDSA44_CLEAN_poly_challenge(poly *c, const uint8_t seed[CTILDEBYTE
     unsigned int i, b, pos;
     uint64_t signs;
     uint8_t buf[SHAKE256_RATE];
-    shake256incctx state;
+    shake256incstate state;
+    DBENCH_START();
 
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, seed, CTILDEBYTES);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(buf, sizeof buf, &state);
+    shake256_inc_state_init(&state);
+    shake256_inc_state_absorb(&state, seed, CTILDEBYTES);
+    shake256_inc_state_finalize(&state);
+    shake256_inc_state_squeeze(buf, sizeof buf, &state);
 
     signs = 0;
     for (i = 0; i < 8; ++i) {
@@ -500,7 +621,7 @@ void PQCLEAN_MLDSA44_CLEAN_poly_challenge(poly *c, const uint8_t seed[CTILDEBYTE
     for (i = N - TAU; i < N; ++i) {
         do {
             if (pos >= SHAKE256_RATE) {
-                shake256_inc_squeeze(buf, sizeof buf, &state);
+                shake256_inc_state_squeeze(buf, sizeof buf, &state);
                 pos = 0;
             }
 
@@ -511,7 +632,7 @@ void PQCLEAN_MLDSA44_CLEAN_poly_challenge(poly *c, const uint8_t seed[CTILDEBYTE
         c->coeffs[b] = 1 - 2 * (signs & 1);
         signs >>= 1;
     }
-    shake256_inc_ctx_release(&state);
+    DBENCH_STOP(*tsample);
 }
 
 /*************************************************
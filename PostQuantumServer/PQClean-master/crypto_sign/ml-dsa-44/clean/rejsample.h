@@ -0,0 +1,21 @@
+#ifndef PQCLEAN_MLDSA44_CLEAN_REJSAMPLE_H
+#define PQCLEAN_MLDSA44_CLEAN_REJSAMPLE_H
+#include "ntt.h"
+#include "params.h"
+#include <stdint.h>
+
+/* Portable sampler (poly.c) */
+unsigned int PQCLEAN_MLDSA44_CLEAN_rej_uniform(int32_t *a,
+        unsigned int len,
+        const uint8_t *buf,
+        unsigned int buflen);
+
+/* AVX2 sampler (rejsample_avx2.c), available together with the AVX2 NTT */
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+unsigned int PQCLEAN_MLDSA44_CLEAN_rej_uniform_avx2(int32_t *a,
+        unsigned int len,
+        const uint8_t *buf,
+        unsigned int buflen);
+#endif
+
+#endif
@@ -3,10 +3,12 @@
 #include "params.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "pqbench.h"
 #include "randombytes.h"
 #include "sign.h"
 #include "symmetric.h"
 #include <stdint.h>
+#include <stdlib.h>
 
 /*************************************************
 * Name:        PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair
@@ -67,69 +69,136 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
 }
 
 /*************************************************
-* Name:        crypto_sign_signature
+* Name:        signer_expand
 *
-* Description: Computes signature.
+* Description: Unpacks a secret key, expands the public matrix and
+*              transforms s1, s2 and t0 to the NTT domain.
+*
+* Arguments:   - signer *signer: pointer to output signing context
+*              - const uint8_t *sk: pointer to bit-packed secret key
+**************************************************/
+static void signer_expand(PQCLEAN_MLDSA44_CLEAN_signer *signer, const uint8_t *sk) {
+    uint8_t rho[SEEDBYTES];
+
+    PQCLEAN_MLDSA44_CLEAN_unpack_sk(rho, signer->tr, signer->key, &signer->t0, &signer->s1, &signer->s2, sk);
+
+    /* Expand matrix and transform vectors */
+    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(signer->mat, rho);
+    PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(&signer->s1);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(&signer->s2);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(&signer->t0);
+}
+
+/*************************************************
+* Name:        signer_wipe
+*
+* Description: Overwrites a signing context so the secret key does not
+*              linger in memory.
+*
+* Arguments:   - signer *signer: pointer to signing context
+**************************************************/
+static void signer_wipe(PQCLEAN_MLDSA44_CLEAN_signer *signer) {
+    volatile uint8_t *p = (volatile uint8_t *)signer;
+    size_t i;
+
+    for (i = 0; i < sizeof(*signer); ++i) {
+        p[i] = 0;
+    }
+}
+
+/*************************************************
+* Name:        stream_wipe
+*
+* Description: Overwrites a finished stream state so the absorbed message
+*              does not linger in memory.
+*
+* Arguments:   - sign_stream *stream: pointer to stream state
+**************************************************/
+static void stream_wipe(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream) {
+    volatile uint8_t *p = (volatile uint8_t *)stream;
+    size_t i;
+
+    for (i = 0; i < sizeof(*stream); ++i) {
+        p[i] = 0;
+    }
+}
+
+/*************************************************
+* Name:        mu_init
+*
+* Description: Starts mu = CRH(tr, 0, ctxlen, ctx, msg): absorbs everything
+*              that precedes the message.
+*
+* Arguments:   - shake256incstate *state: pointer to output hash state
+*              - const uint8_t *tr: pointer to H(pk) (TRBYTES bytes)
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string (at most 255)
+**************************************************/
+static void mu_init(shake256incstate *state, const uint8_t tr[TRBYTES], const uint8_t *ctx, size_t ctxlen) {
+    uint8_t pre[2];
+
+    pre[0] = 0;
+    pre[1] = (uint8_t)ctxlen;
+    shake256_inc_state_init(state);
+    shake256_inc_state_absorb(state, tr, TRBYTES);
+    shake256_inc_state_absorb(state, pre, 2);
+    shake256_inc_state_absorb(state, ctx, ctxlen);
+}
+
+/*************************************************
+* Name:        mu_final
+*
+* Description: Finishes mu after the whole message was absorbed.
+*
+* Arguments:   - uint8_t *mu: pointer to output (CRHBYTES bytes)
+*              - shake256incstate *state: pointer to hash state
+**************************************************/
+static void mu_final(uint8_t mu[CRHBYTES], shake256incstate *state) {
+    shake256_inc_state_finalize(state);
+    shake256_inc_state_squeeze(mu, CRHBYTES, state);
+}
+
+/*************************************************
+* Name:        sign_mu
+*
+* Description: Computes signature of a message representative mu with an
+*              expanded signing context.
 *
 * Arguments:   - uint8_t *sig:   pointer to output signature (of length PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES)
 *              - size_t *siglen: pointer to output length of signature
-*              - uint8_t *m:     pointer to message to be signed
-*              - size_t mlen:    length of message
-*              - uint8_t *ctx:   pointer to context string
-*              - size_t ctxlen:  length of context string
-*              - uint8_t *sk:    pointer to bit-packed secret key
+*              - const uint8_t *mu: pointer to mu (CRHBYTES bytes)
+*              - const signer *signer: pointer to expanded signing context
 *
-* Returns 0 (success) or -1 (context string too long)
+* Returns 0 (success)
 **************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(uint8_t *sig,
-        size_t *siglen,
-        const uint8_t *m,
-        size_t mlen,
-        const uint8_t *ctx,
-        size_t ctxlen,
-        const uint8_t *sk) {
+static int sign_mu(uint8_t *sig,
+                   size_t *siglen,
+                   const uint8_t mu_in[CRHBYTES],
+                   const PQCLEAN_MLDSA44_CLEAN_signer *signer) {
     unsigned int n;
-    uint8_t seedbuf[2 * SEEDBYTES + TRBYTES + RNDBYTES + 2 * CRHBYTES];
-    uint8_t *rho, *tr, *key, *mu, *rhoprime, *rnd;
+    uint8_t seedbuf[SEEDBYTES + RNDBYTES + 2 * CRHBYTES];
+    uint8_t *key, *mu, *rhoprime, *rnd;
     uint16_t nonce = 0;
-    polyvecl mat[K], s1, y, z;
-    polyveck t0, s2, w1, w0, h;
+    polyvecl y, z;
+    polyveck w1, w0, h;
     poly cp;
-    shake256incctx state;
-
-    if (ctxlen > 255) {
-        return -1;
-    }
+    shake256incstate state;
+    size_t i;
 
-    rho = seedbuf;
-    tr = rho + SEEDBYTES;
-    key = tr + TRBYTES;
+    key = seedbuf;
     rnd = key + SEEDBYTES;
     mu = rnd + RNDBYTES;
     rhoprime = mu + CRHBYTES;
-    PQCLEAN_MLDSA44_CLEAN_unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
-
-    /* Compute mu = CRH(tr, 0, ctxlen, ctx, msg) */
-    mu[0] = 0;
-    mu[1] = (uint8_t)ctxlen;
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, tr, TRBYTES);
-    shake256_inc_absorb(&state, mu, 2);
-    shake256_inc_absorb(&state, ctx, ctxlen);
-    shake256_inc_absorb(&state, m, mlen);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(mu, CRHBYTES, &state);
-    shake256_inc_ctx_release(&state);
+    for (i = 0; i < SEEDBYTES; ++i) {
+        key[i] = signer->key[i];
+    }
+    for (i = 0; i < CRHBYTES; ++i) {
+        mu[i] = mu_in[i];
+    }
 
     randombytes(rnd, RNDBYTES);
     shake256(rhoprime, CRHBYTES, key, SEEDBYTES + RNDBYTES + CRHBYTES);
 
-    /* Expand matrix and transform vectors */
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(mat, rho);
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(&s1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(&s2);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(&t0);
-
 rej:
     /* Sample intermediate vector y */
     PQCLEAN_MLDSA44_CLEAN_polyvecl_uniform_gamma1(&y, rhoprime, nonce++);
@@ -137,7 +206,7 @@ rej:
     /* Matrix-vector multiplication */
     z = y;
     PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(&z);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(&w1, signer->mat, &z);
     PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(&w1);
     PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(&w1);
 
@@ -146,17 +215,16 @@ rej:
     PQCLEAN_MLDSA44_CLEAN_polyveck_decompose(&w1, &w0, &w1);
     PQCLEAN_MLDSA44_CLEAN_polyveck_pack_w1(sig, &w1);
 
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, mu, CRHBYTES);
-    shake256_inc_absorb(&state, sig, K * POLYW1_PACKEDBYTES);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(sig, CTILDEBYTES, &state);
-    shake256_inc_ctx_release(&state);
+    shake256_inc_state_init(&state);
+    shake256_inc_state_absorb(&state, mu, CRHBYTES);
+    shake256_inc_state_absorb(&state, sig, K * POLYW1_PACKEDBYTES);
+    shake256_inc_state_finalize(&state);
+    shake256_inc_state_squeeze(sig, CTILDEBYTES, &state);
     PQCLEAN_MLDSA44_CLEAN_poly_challenge(&cp, sig);
     PQCLEAN_MLDSA44_CLEAN_poly_ntt(&cp);
 
     /* Compute z, reject if it reveals secret */
-    PQCLEAN_MLDSA44_CLEAN_polyvecl_pointwise_poly_montgomery(&z, &cp, &s1);
+    PQCLEAN_MLDSA44_CLEAN_polyvecl_pointwise_poly_montgomery(&z, &cp, &signer->s1);
     PQCLEAN_MLDSA44_CLEAN_polyvecl_invntt_tomont(&z);
     PQCLEAN_MLDSA44_CLEAN_polyvecl_add(&z, &z, &y);
     PQCLEAN_MLDSA44_CLEAN_polyvecl_reduce(&z);
@@ -166,7 +234,7 @@ rej:
 
     /* Check that subtracting cs2 does not change high bits of w and low bits
      * do not reveal secret information */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(&h, &cp, &s2);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(&h, &cp, &signer->s2);
     PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(&h);
     PQCLEAN_MLDSA44_CLEAN_polyveck_sub(&w0, &w0, &h);
     PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(&w0);
@@ -175,7 +243,7 @@ rej:
     }
 
     /* Compute hints for w1 */
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(&h, &cp, &t0);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(&h, &cp, &signer->t0);
     PQCLEAN_MLDSA44_CLEAN_polyveck_invntt_tomont(&h);
     PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(&h);
     if (PQCLEAN_MLDSA44_CLEAN_polyveck_chknorm(&h, GAMMA2)) {
@@ -194,6 +262,180 @@ rej:
     return 0;
 }
 
+/*************************************************
+* Name:        sign_prepared
+*
+* Description: Computes signature with an expanded signing context.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - const signer *signer: pointer to expanded signing context
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+static int sign_prepared(uint8_t *sig,
+                         size_t *siglen,
+                         const uint8_t *m,
+                         size_t mlen,
+                         const uint8_t *ctx,
+                         size_t ctxlen,
+                         const PQCLEAN_MLDSA44_CLEAN_signer *signer) {
+    uint8_t mu[CRHBYTES];
+    shake256incstate state;
+
+    if (ctxlen > 255) {
+        return -1;
+    }
+
+    /* Compute mu = CRH(tr, 0, ctxlen, ctx, msg) */
+    mu_init(&state, signer->tr, ctx, ctxlen);
+    shake256_inc_state_absorb(&state, m, mlen);
+    mu_final(mu, &state);
+
+    return sign_mu(sig, siglen, mu, signer);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature
+*
+* Description: Computes signature.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - uint8_t *sk:    pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *sk) {
+    PQCLEAN_MLDSA44_CLEAN_signer signer;
+    int ret;
+
+    if (ctxlen > 255) {
+        return -1;
+    }
+
+    DBENCH_OP_START(PQCLEAN_BENCH_SIGN);
+    signer_expand(&signer, sk);
+    ret = sign_prepared(sig, siglen, m, mlen, ctx, ctxlen, &signer);
+    signer_wipe(&signer);
+    DBENCH_OP_STOP();
+    return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_signer_new
+*
+* Description: Creates a signing context holding the secret key unpacked,
+*              the matrix expanded and s1, s2, t0 in the NTT domain, so
+*              that repeated signatures skip all key-dependent setup.
+*
+* Arguments:   - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns pointer to the context or NULL if allocation failed
+**************************************************/
+PQCLEAN_MLDSA44_CLEAN_signer *PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_new(const uint8_t *sk) {
+    PQCLEAN_MLDSA44_CLEAN_signer *signer = malloc(sizeof(PQCLEAN_MLDSA44_CLEAN_signer));
+
+    if (signer == NULL) {
+        return NULL;
+    }
+    signer_expand(signer, sk);
+    return signer;
+}
+
+/*************************************************
+* Name:        crypto_sign_signer_free
+*
+* Description: Wipes and frees a signing context.
+*
+* Arguments:   - signer *signer: pointer to signing context (may be NULL)
+**************************************************/
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free(PQCLEAN_MLDSA44_CLEAN_signer *signer) {
+    if (signer == NULL) {
+        return;
+    }
+    signer_wipe(signer);
+    free(signer);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_signer
+*
+* Description: Computes signature with a prepared signing context. The
+*              output is a regular signature for the context's key.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - const signer *signer: pointer to signing context
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_signer(uint8_t *sig,
+        size_t *siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const PQCLEAN_MLDSA44_CLEAN_signer *signer) {
+    int ret;
+
+    DBENCH_OP_START(PQCLEAN_BENCH_SIGN);
+    ret = sign_prepared(sig, siglen, m, mlen, ctx, ctxlen, signer);
+    DBENCH_OP_STOP();
+    return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_batch
+*
+* Description: Signs count messages (empty context string) with one
+*              prepared signing context.
+*
+* Arguments:   - uint8_t *sigs:     pointer to output signatures, count
+*                                   consecutive blocks of PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES
+*              - size_t *siglens:   pointer to count output signature lengths
+*              - const uint8_t *const *m: pointer to count message pointers
+*              - const size_t *mlen: pointer to count message lengths
+*              - size_t count:      number of messages
+*              - const signer *signer: pointer to signing context
+*
+* Returns 0 (success)
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_batch(uint8_t *sigs,
+        size_t *siglens,
+        const uint8_t *const *m,
+        const size_t *mlen,
+        size_t count,
+        const PQCLEAN_MLDSA44_CLEAN_signer *signer) {
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        DBENCH_OP_START(PQCLEAN_BENCH_SIGN);
+        sign_prepared(sigs + i * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES, &siglens[i],
+                      m[i], mlen[i], NULL, 0, signer);
+        DBENCH_OP_STOP();
+    }
+    return 0;
+}
+
 /*************************************************
 * Name:        crypto_sign
 *
@@ -231,43 +473,55 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_ctx(uint8_t *sm,
 }
 
 /*************************************************
-* Name:        crypto_sign_verify
+* Name:        verifier_expand
 *
-* Description: Verifies signature.
+* Description: Unpacks a public key, computes tr = H(pk), expands the
+*              public matrix and stores NTT(t1*2^d).
+*
+* Arguments:   - verifier *verifier: pointer to output verification context
+*              - const uint8_t *pk: pointer to bit-packed public key
+**************************************************/
+static void verifier_expand(PQCLEAN_MLDSA44_CLEAN_verifier *verifier, const uint8_t *pk) {
+    uint8_t rho[SEEDBYTES];
+
+    PQCLEAN_MLDSA44_CLEAN_unpack_pk(rho, &verifier->t1, pk);
+    shake256(verifier->tr, TRBYTES, pk, PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES);
+
+    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(verifier->mat, rho);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_shiftl(&verifier->t1);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(&verifier->t1);
+}
+
+/*************************************************
+* Name:        verify_mu
+*
+* Description: Verifies signature of a message representative mu with an
+*              expanded verification context.
 *
 * Arguments:   - uint8_t *m: pointer to input signature
 *              - size_t siglen: length of signature
-*              - const uint8_t *m: pointer to message
-*              - size_t mlen: length of message
-*              - const uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
-*              - const uint8_t *pk: pointer to bit-packed public key
+*              - const uint8_t *mu: pointer to mu (CRHBYTES bytes)
+*              - const verifier *verifier: pointer to expanded verification context
 *
 * Returns 0 if signature could be verified correctly and -1 otherwise
 **************************************************/
-int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig,
-        size_t siglen,
-        const uint8_t *m,
-        size_t mlen,
-        const uint8_t *ctx,
-        size_t ctxlen,
-        const uint8_t *pk) {
+static int verify_mu(const uint8_t *sig,
+                     size_t siglen,
+                     const uint8_t mu[CRHBYTES],
+                     const PQCLEAN_MLDSA44_CLEAN_verifier *verifier) {
     unsigned int i;
     uint8_t buf[K * POLYW1_PACKEDBYTES];
-    uint8_t rho[SEEDBYTES];
-    uint8_t mu[CRHBYTES];
     uint8_t c[CTILDEBYTES];
     uint8_t c2[CTILDEBYTES];
     poly cp;
-    polyvecl mat[K], z;
+    polyvecl z;
     polyveck t1, w1, h;
-    shake256incctx state;
+    shake256incstate state;
 
-    if (ctxlen > 255 || siglen != PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
+    if (siglen != PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
         return -1;
     }
 
-    PQCLEAN_MLDSA44_CLEAN_unpack_pk(rho, &t1, pk);
     if (PQCLEAN_MLDSA44_CLEAN_unpack_sig(c, &z, &h, sig)) {
         return -1;
     }
@@ -275,30 +529,14 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig,
         return -1;
     }
 
-    /* Compute CRH(H(rho, t1), msg) */
-    shake256(mu, TRBYTES, pk, PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES);
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, mu, TRBYTES);
-    mu[0] = 0;
-    mu[1] = (uint8_t)ctxlen;
-    shake256_inc_absorb(&state, mu, 2);
-    shake256_inc_absorb(&state, ctx, ctxlen);
-    shake256_inc_absorb(&state, m, mlen);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(mu, CRHBYTES, &state);
-    shake256_inc_ctx_release(&state);
-
     /* Matrix-vector multiplication; compute Az - c2^dt1 */
     PQCLEAN_MLDSA44_CLEAN_poly_challenge(&cp, c);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_expand(mat, rho);
 
     PQCLEAN_MLDSA44_CLEAN_polyvecl_ntt(&z);
-    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+    PQCLEAN_MLDSA44_CLEAN_polyvec_matrix_pointwise_montgomery(&w1, verifier->mat, &z);
 
     PQCLEAN_MLDSA44_CLEAN_poly_ntt(&cp);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_shiftl(&t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_ntt(&t1);
-    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(&t1, &cp, &t1);
+    PQCLEAN_MLDSA44_CLEAN_polyveck_pointwise_poly_montgomery(&t1, &cp, &verifier->t1);
 
     PQCLEAN_MLDSA44_CLEAN_polyveck_sub(&w1, &w1, &t1);
     PQCLEAN_MLDSA44_CLEAN_polyveck_reduce(&w1);
@@ -310,12 +548,11 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig,
     PQCLEAN_MLDSA44_CLEAN_polyveck_pack_w1(buf, &w1);
 
     /* Call random oracle and verify challenge */
-    shake256_inc_init(&state);
-    shake256_inc_absorb(&state, mu, CRHBYTES);
-    shake256_inc_absorb(&state, buf, K * POLYW1_PACKEDBYTES);
-    shake256_inc_finalize(&state);
-    shake256_inc_squeeze(c2, CTILDEBYTES, &state);
-    shake256_inc_ctx_release(&state);
+    shake256_inc_state_init(&state);
+    shake256_inc_state_absorb(&state, mu, CRHBYTES);
+    shake256_inc_state_absorb(&state, buf, K * POLYW1_PACKEDBYTES);
+    shake256_inc_state_finalize(&state);
+    shake256_inc_state_squeeze(c2, CTILDEBYTES, &state);
     for (i = 0; i < CTILDEBYTES; ++i) {
         if (c[i] != c2[i]) {
             return -1;
@@ -325,6 +562,187 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig,
     return 0;
 }
 
+/*************************************************
+* Name:        verify_prepared
+*
+* Description: Verifies signature with an expanded verification context.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const verifier *verifier: pointer to expanded verification context
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+static int verify_prepared(const uint8_t *sig,
+                           size_t siglen,
+                           const uint8_t *m,
+                           size_t mlen,
+                           const uint8_t *ctx,
+                           size_t ctxlen,
+                           const PQCLEAN_MLDSA44_CLEAN_verifier *verifier) {
+    uint8_t mu[CRHBYTES];
+    shake256incstate state;
+
+    if (ctxlen > 255 || siglen != PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
+        return -1;
+    }
+
+    /* Compute CRH(H(rho, t1), msg) */
+    mu_init(&state, verifier->tr, ctx, ctxlen);
+    shake256_inc_state_absorb(&state, m, mlen);
+    mu_final(mu, &state);
+
+    return verify_mu(sig, siglen, mu, verifier);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify
+*
+* Description: Verifies signature.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(const uint8_t *sig,
+        size_t siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk) {
+    PQCLEAN_MLDSA44_CLEAN_verifier verifier;
+    int ret;
+
+    if (ctxlen > 255 || siglen != PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
+        return -1;
+    }
+
+    DBENCH_OP_START(PQCLEAN_BENCH_VERIFY);
+    verifier_expand(&verifier, pk);
+    ret = verify_prepared(sig, siglen, m, mlen, ctx, ctxlen, &verifier);
+    DBENCH_OP_STOP();
+    return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_verifier_new
+*
+* Description: Creates a verification context holding tr = H(pk), the
+*              expanded matrix and NTT(t1*2^d), so that repeated
+*              verifications under one public key skip all key-dependent
+*              setup.
+*
+* Arguments:   - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns pointer to the context or NULL if allocation failed
+**************************************************/
+PQCLEAN_MLDSA44_CLEAN_verifier *PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_new(const uint8_t *pk) {
+    PQCLEAN_MLDSA44_CLEAN_verifier *verifier = malloc(sizeof(PQCLEAN_MLDSA44_CLEAN_verifier));
+
+    if (verifier == NULL) {
+        return NULL;
+    }
+    verifier_expand(verifier, pk);
+    return verifier;
+}
+
+/*************************************************
+* Name:        crypto_sign_verifier_free
+*
+* Description: Frees a verification context.
+*
+* Arguments:   - verifier *verifier: pointer to verification context (may be NULL)
+**************************************************/
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free(PQCLEAN_MLDSA44_CLEAN_verifier *verifier) {
+    free(verifier);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_verifier
+*
+* Description: Verifies signature with a prepared verification context.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const verifier *verifier: pointer to verification context
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_verifier(const uint8_t *sig,
+        size_t siglen,
+        const uint8_t *m,
+        size_t mlen,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const PQCLEAN_MLDSA44_CLEAN_verifier *verifier) {
+    int ret;
+
+    DBENCH_OP_START(PQCLEAN_BENCH_VERIFY);
+    ret = verify_prepared(sig, siglen, m, mlen, ctx, ctxlen, verifier);
+    DBENCH_OP_STOP();
+    return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_batch
+*
+* Description: Verifies count (signature, message) pairs (empty context
+*              string) with one prepared verification context.
+*
+* Arguments:   - const uint8_t *sigs: pointer to signatures, count consecutive
+*                                     blocks of PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES
+*              - const size_t *siglens: pointer to count signature lengths
+*              - const uint8_t *const *m: pointer to count message pointers
+*              - const size_t *mlen: pointer to count message lengths
+*              - size_t count: number of pairs
+*              - uint8_t *ok: pointer to output bitmap of (count + 7) / 8
+*                             bytes; bit i % 8 of byte i / 8 is set if
+*                             pair i verified
+*              - const verifier *verifier: pointer to verification context
+*
+* Returns 0 if all pairs verified correctly and -1 otherwise
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_batch(const uint8_t *sigs,
+        const size_t *siglens,
+        const uint8_t *const *m,
+        const size_t *mlen,
+        size_t count,
+        uint8_t *ok,
+        const PQCLEAN_MLDSA44_CLEAN_verifier *verifier) {
+    size_t i;
+    int ret = 0;
+
+    for (i = 0; i < (count + 7) / 8; ++i) {
+        ok[i] = 0;
+    }
+    for (i = 0; i < count; ++i) {
+        DBENCH_OP_START(PQCLEAN_BENCH_VERIFY);
+        if (verify_prepared(sigs + i * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES, siglens[i],
+                            m[i], mlen[i], NULL, 0, verifier) == 0) {
+            ok[i / 8] |= (uint8_t)(1u << (i % 8));
+        } else {
+            ret = -1;
+        }
+        DBENCH_OP_STOP();
+    }
+    return ret;
+}
+
 /*************************************************
 * Name:        crypto_sign_open
 *
@@ -405,3 +823,154 @@ int PQCLEAN_MLDSA44_CLEAN_crypto_sign_open(uint8_t *m,
         const uint8_t *pk) {
     return PQCLEAN_MLDSA44_CLEAN_crypto_sign_open_ctx(m, mlen, sm, smlen, NULL, 0, pk);
 }
+
+/*************************************************
+* Name:        crypto_sign_signature_init
+*
+* Description: Starts a streaming signature. The message is then passed in
+*              any number of crypto_sign_signature_update calls; the result
+*              of crypto_sign_signature_final is a regular signature, the
+*              same as crypto_sign_signature_ctx over the concatenated
+*              chunks.
+*
+* Arguments:   - sign_stream *stream: pointer to output stream state
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_init(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *sk) {
+    if (ctxlen > 255) {
+        return -1;
+    }
+
+    /* sk = (rho, key, tr, ...) */
+    mu_init(&stream->state, sk + 2 * SEEDBYTES, ctx, ctxlen);
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_update
+*
+* Description: Absorbs the next chunk of the message being signed.
+*
+* Arguments:   - sign_stream *stream: pointer to stream state
+*              - const uint8_t *m: pointer to message chunk
+*              - size_t mlen: length of message chunk
+**************************************************/
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_update(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *m,
+        size_t mlen) {
+    shake256_inc_state_absorb(&stream->state, m, mlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_final
+*
+* Description: Computes the signature of the streamed message.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - sign_stream *stream: pointer to stream state (consumed and wiped)
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*                                   (the one passed to init)
+*
+* Returns 0 (success)
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_final(uint8_t *sig,
+        size_t *siglen,
+        PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *sk) {
+    PQCLEAN_MLDSA44_CLEAN_signer signer;
+    uint8_t mu[CRHBYTES];
+    int ret;
+
+    DBENCH_OP_START(PQCLEAN_BENCH_SIGN);
+    mu_final(mu, &stream->state);
+    stream_wipe(stream);
+    signer_expand(&signer, sk);
+    ret = sign_mu(sig, siglen, mu, &signer);
+    signer_wipe(&signer);
+    DBENCH_OP_STOP();
+    return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_init
+*
+* Description: Starts a streaming verification; see
+*              crypto_sign_signature_init.
+*
+* Arguments:   - sign_stream *stream: pointer to output stream state
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_init(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *ctx,
+        size_t ctxlen,
+        const uint8_t *pk) {
+    uint8_t tr[TRBYTES];
+
+    if (ctxlen > 255) {
+        return -1;
+    }
+
+    shake256(tr, TRBYTES, pk, PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES);
+    mu_init(&stream->state, tr, ctx, ctxlen);
+    return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_update
+*
+* Description: Absorbs the next chunk of the message being verified.
+*
+* Arguments:   - sign_stream *stream: pointer to stream state
+*              - const uint8_t *m: pointer to message chunk
+*              - size_t mlen: length of message chunk
+**************************************************/
+void PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_update(PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *m,
+        size_t mlen) {
+    shake256_inc_state_absorb(&stream->state, m, mlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_final
+*
+* Description: Verifies a signature of the streamed message.
+*
+* Arguments:   - const uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - sign_stream *stream: pointer to stream state (consumed and wiped)
+*              - const uint8_t *pk: pointer to bit-packed public key
+*                                   (the one passed to init)
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_final(const uint8_t *sig,
+        size_t siglen,
+        PQCLEAN_MLDSA44_CLEAN_sign_stream *stream,
+        const uint8_t *pk) {
+    PQCLEAN_MLDSA44_CLEAN_verifier verifier;
+    uint8_t mu[CRHBYTES];
+    int ret;
+
+    mu_final(mu, &stream->state);
+    stream_wipe(stream);
+    if (siglen != PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
+        return -1;
+    }
+    DBENCH_OP_START(PQCLEAN_BENCH_VERIFY);
+    verifier_expand(&verifier, pk);
+    ret = verify_mu(sig, siglen, mu, &verifier);
+    DBENCH_OP_STOP();
+    return ret;
+}
@@ -5,14 +5,14 @@
 #include <stdint.h>
 
 
-typedef shake128incctx stream128_state;
-typedef shake256incctx stream256_state;
+typedef shake128incstate stream128_state;
+typedef shake256incstate stream256_state;
 
-void PQCLEAN_MLDSA44_CLEAN_dilithium_shake128_stream_init(shake128incctx *state,
+void PQCLEAN_MLDSA44_CLEAN_dilithium_shake128_stream_init(shake128incstate *state,
         const uint8_t seed[SEEDBYTES],
         uint16_t nonce);
 
-void PQCLEAN_MLDSA44_CLEAN_dilithium_shake256_stream_init(shake256incctx *state,
+void PQCLEAN_MLDSA44_CLEAN_dilithium_shake256_stream_init(shake256incstate *state,
         const uint8_t seed[CRHBYTES],
         uint16_t nonce);
 
@@ -22,13 +22,11 @@ void PQCLEAN_MLDSA44_CLEAN_dilithium_shake256_stream_init(shake256incctx *state,
 #define stream128_init(STATE, SEED, NONCE) \
     PQCLEAN_MLDSA44_CLEAN_dilithium_shake128_stream_init(STATE, SEED, NONCE)
 #define stream128_squeezeblocks(OUT, OUTBLOCKS, STATE) \
-    shake128_inc_squeeze(OUT, (OUTBLOCKS)*(SHAKE128_RATE), STATE)
-#define stream128_release(STATE) shake128_inc_ctx_release(STATE)
+    shake128_inc_state_squeeze(OUT, (OUTBLOCKS)*(SHAKE128_RATE), STATE)
 
 #define stream256_init(STATE, SEED, NONCE) \
     PQCLEAN_MLDSA44_CLEAN_dilithium_shake256_stream_init(STATE, SEED, NONCE)
 #define stream256_squeezeblocks(OUT, OUTBLOCKS, STATE) \
-    shake256_inc_squeeze(OUT, (OUTBLOCKS)*(SHAKE256_RATE), STATE)
-#define stream256_release(STATE) shake256_inc_ctx_release(STATE)
+    shake256_inc_state_squeeze(OUT, (OUTBLOCKS)*(SHAKE256_RATE), STATE)
 
 #endif
@@ -0,0 +1,112 @@
+/*
+ * ML-DSA-44 batch API: crypto_sign_signature_batch must produce regular
+ * signatures, and crypto_sign_verify_batch must report every pair in its
+ * bitmap and return -1 as soon as one pair fails. 11 messages make the
+ * bitmap span two bytes with unused high bits in the second, which must
+ * stay clear. randombytes is replaced by the fixed-seed test generator.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../crypto_sign/ml-dsa-44/clean/api.h"
+#include "randombytes.h"
+#include "testrng.h"
+
+#define COUNT 11
+#define BITMAP_BYTES ((COUNT + 7) / 8)
+#define MAX_MLEN (COUNT * 29)
+#define DSA_PK PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES
+#define DSA_SK PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES
+#define DSA_SIG PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES
+
+/* Replaces the system generator of common/randombytes.c */
+int randombytes(uint8_t *output, size_t n) {
+    test_rand_bytes(output, n);
+    return 0;
+}
+
+/* Runs verify_batch and compares the return value and the bitmap bytes */
+static int check_verify(const char *what, const uint8_t *sigs, const size_t *siglens,
+                        const uint8_t *const *m, const size_t *mlen,
+                        const PQCLEAN_MLDSA44_CLEAN_verifier *verifier,
+                        int want_ret, const uint8_t want_ok[BITMAP_BYTES]) {
+    uint8_t ok[BITMAP_BYTES];
+    int ret;
+
+    /* Stale bits must be cleared, not kept */
+    memset(ok, 0xAA, sizeof(ok));
+    ret = PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_batch(sigs, siglens, m, mlen, COUNT, ok, verifier);
+    if (ret != want_ret || memcmp(ok, want_ok, sizeof(ok)) != 0) {
+        fprintf(stderr, "%s: returned %d with bitmap %02x %02x, expected %d with %02x %02x\n",
+                what, ret, ok[0], ok[1], want_ret, want_ok[0], want_ok[1]);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    static uint8_t messages[COUNT][MAX_MLEN];
+    static uint8_t sigs[COUNT * DSA_SIG];
+    const uint8_t *m[COUNT];
+    size_t mlen[COUNT], siglens[COUNT];
+    uint8_t pk[DSA_PK], sk[DSA_SK];
+    PQCLEAN_MLDSA44_CLEAN_signer *signer;
+    PQCLEAN_MLDSA44_CLEAN_verifier *verifier;
+    /* Items 3 (flipped byte) and 9 (short length) fail below */
+    static const uint8_t all_ok[BITMAP_BYTES] = { 0xFF, 0x07 };
+    static const uint8_t tampered_ok[BITMAP_BYTES] = { 0xF7, 0x05 };
+    uint8_t empty_ok = 0xAA;
+    unsigned int i;
+    int failures = 0;
+
+    PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(pk, sk);
+    signer = PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_new(sk);
+    verifier = PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_new(pk);
+    if (signer == NULL || verifier == NULL) {
+        fprintf(stderr, "could not allocate the contexts\n");
+        return 1;
+    }
+
+    for (i = 0; i < COUNT; i++) {
+        mlen[i] = 29 * i;
+        test_rand_bytes(messages[i], mlen[i]);
+        m[i] = messages[i];
+        siglens[i] = 0;
+    }
+
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_batch(sigs, siglens, m, mlen, COUNT, signer) != 0) {
+        fprintf(stderr, "signature_batch failed\n");
+        return 1;
+    }
+    for (i = 0; i < COUNT; i++) {
+        if (siglens[i] != DSA_SIG ||
+                PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify(sigs + i * DSA_SIG, siglens[i], m[i], mlen[i], pk) != 0) {
+            fprintf(stderr, "signature_batch: signature %u does not verify\n", i);
+            failures++;
+        }
+    }
+
+    failures += check_verify("all valid", sigs, siglens, m, mlen, verifier, 0, all_ok);
+
+    sigs[3 * DSA_SIG + 100] ^= 0x01;
+    siglens[9] -= 1;
+    failures += check_verify("items 3 and 9 tampered", sigs, siglens, m, mlen, verifier, -1, tampered_ok);
+
+    /* An empty batch verifies trivially and writes no bitmap byte */
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_batch(sigs, siglens, m, mlen, 0, &empty_ok, verifier) != 0 ||
+            empty_ok != 0xAA) {
+        fprintf(stderr, "empty batch: wrong result\n");
+        failures++;
+    }
+
+    PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free(signer);
+    PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free(verifier);
+    if (failures > 0) {
+        return 1;
+    }
+    printf("%u signatures: batch results and bitmaps as expected\n", COUNT);
+    return 0;
+}
@@ -0,0 +1,19 @@
+# Runs FIRST and SECOND and fails unless both succeed with identical stdout.
+# Usage: cmake -DFIRST=<program> -DSECOND=<program> -P compare_outputs.cmake
+
+execute_process(COMMAND "${FIRST}" OUTPUT_VARIABLE first_out RESULT_VARIABLE first_rc)
+execute_process(COMMAND "${SECOND}" OUTPUT_VARIABLE second_out RESULT_VARIABLE second_rc)
+
+if (NOT first_rc EQUAL 0)
+    message(FATAL_ERROR "${FIRST} failed (${first_rc})")
+endif()
+if (NOT second_rc EQUAL 0)
+    message(FATAL_ERROR "${SECOND} failed (${second_rc})")
+endif()
+if (NOT first_out STREQUAL second_out)
+    message(FATAL_ERROR "Outputs differ:\n${FIRST}:\n${first_out}\n${SECOND}:\n${second_out}")
+endif()
+
+string(REGEX MATCHALL "\n" lines "${first_out}")
+list(LENGTH lines count)
+message(STATUS "${count} lines identical")
@@ -0,0 +1,94 @@
+/*
+ * ML-DSA-44 AVX2 kernels (ntt_avx2.c) against the clean code: NTT, inverse
+ * NTT and pointwise Montgomery multiplication must agree bit for bit on
+ * random inputs. Input ranges are the widest the clean code handles without
+ * int32 overflow, covering what the signing and verification paths feed in:
+ * |a| < 9Q for the NTT and pointwise product, |a| < Q for the inverse NTT.
+ * Skipped without AVX2.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../crypto_sign/ml-dsa-44/clean/ntt.h"
+#include "../crypto_sign/ml-dsa-44/clean/params.h"
+#include "../crypto_sign/ml-dsa-44/clean/reduce.h"
+#include "testrng.h"
+
+#define ITERATIONS 20000
+
+#ifdef PQCLEAN_MLDSA44_CLEAN_NTT_AVX2
+
+/* Coefficients uniform in (-bound, bound) */
+static void random_poly(int32_t r[N], int32_t bound) {
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        r[i] = (int32_t)test_rand_below(2 * (uint32_t)bound - 1) - (bound - 1);
+    }
+}
+
+/* Report the first differing coefficient; 0 if equal */
+static int check(const char *kernel, unsigned int iteration, const int32_t *got, const int32_t *want) {
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        if (got[i] != want[i]) {
+            fprintf(stderr, "%s: iteration %u, coefficient %u: avx2 %d, clean %d\n",
+                    kernel, iteration, i, got[i], want[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int32_t a[N], b[N], want[N], got[N];
+    unsigned int n, i;
+    int failures = 0;
+
+    if (!PQCLEAN_MLDSA44_CLEAN_avx2_available()) {
+        printf("AVX2 not available: skipped\n");
+        return TEST_SKIPPED;
+    }
+
+    for (n = 0; n < ITERATIONS; n++) {
+        random_poly(a, 9 * Q);
+        memcpy(want, a, sizeof(a));
+        memcpy(got, a, sizeof(a));
+        PQCLEAN_MLDSA44_CLEAN_ntt(want);
+        PQCLEAN_MLDSA44_CLEAN_ntt_avx2(got);
+        failures += check("ntt", n, got, want);
+
+        random_poly(a, Q);
+        memcpy(want, a, sizeof(a));
+        memcpy(got, a, sizeof(a));
+        PQCLEAN_MLDSA44_CLEAN_invntt_tomont(want);
+        PQCLEAN_MLDSA44_CLEAN_invntt_tomont_avx2(got);
+        failures += check("invntt_tomont", n, got, want);
+
+        random_poly(a, 9 * Q);
+        random_poly(b, 9 * Q);
+        for (i = 0; i < N; i++) {
+            want[i] = PQCLEAN_MLDSA44_CLEAN_montgomery_reduce((int64_t)a[i] * b[i]);
+        }
+        PQCLEAN_MLDSA44_CLEAN_pointwise_montgomery_avx2(got, a, b);
+        failures += check("pointwise_montgomery", n, got, want);
+
+        if (failures > 0) {
+            return 1;
+        }
+    }
+    printf("%u random inputs per kernel: identical\n", ITERATIONS);
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("AVX2 kernels not built: skipped\n");
+    return TEST_SKIPPED;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * ML-KEM-512 AVX2 kernels (ntt_avx2.c) against the clean code: NTT, inverse
+ * NTT, base multiplication and Barrett reduction must agree bit for bit on
+ * random inputs over the whole int16 range. Skipped without AVX2.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../crypto_kem/ml-kem-512/clean/ntt.h"
+#include "../crypto_kem/ml-kem-512/clean/reduce.h"
+#include "testrng.h"
+
+#define ITERATIONS 20000
+
+#ifdef PQCLEAN_MLKEM512_CLEAN_NTT_AVX2
+
+static void random_poly(int16_t r[256]) {
+    test_rand_bytes((uint8_t *)r, 256 * sizeof(int16_t));
+}
+
+/* Report the first differing coefficient; 0 if equal */
+static int check(const char *kernel, unsigned int iteration, const int16_t *got, const int16_t *want) {
+    unsigned int i;
+
+    for (i = 0; i < 256; i++) {
+        if (got[i] != want[i]) {
+            fprintf(stderr, "%s: iteration %u, coefficient %u: avx2 %d, clean %d\n",
+                    kernel, iteration, i, got[i], want[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    int16_t a[256], b[256], want[256], got[256];
+    unsigned int n, i;
+    int failures = 0;
+
+    if (!PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        printf("AVX2 not available: skipped\n");
+        return TEST_SKIPPED;
+    }
+
+    for (n = 0; n < ITERATIONS; n++) {
+        random_poly(a);
+        memcpy(want, a, sizeof(a));
+        memcpy(got, a, sizeof(a));
+        PQCLEAN_MLKEM512_CLEAN_ntt(want);
+        PQCLEAN_MLKEM512_CLEAN_ntt_avx2(got);
+        failures += check("ntt", n, got, want);
+
+        /* poly_ntt: NTT followed by reduction */
+        for (i = 0; i < 256; i++) {
+            want[i] = PQCLEAN_MLKEM512_CLEAN_barrett_reduce(want[i]);
+        }
+        PQCLEAN_MLKEM512_CLEAN_reduce_avx2(got);
+        failures += check("ntt+reduce", n, got, want);
+
+        random_poly(a);
+        memcpy(want, a, sizeof(a));
+        memcpy(got, a, sizeof(a));
+        PQCLEAN_MLKEM512_CLEAN_invntt(want);
+        PQCLEAN_MLKEM512_CLEAN_invntt_avx2(got);
+        failures += check("invntt", n, got, want);
+
+        random_poly(a);
+        random_poly(b);
+        for (i = 0; i < 256 / 4; i++) {
+            PQCLEAN_MLKEM512_CLEAN_basemul(&want[4 * i], &a[4 * i], &b[4 * i], PQCLEAN_MLKEM512_CLEAN_zetas[64 + i]);
+            PQCLEAN_MLKEM512_CLEAN_basemul(&want[4 * i + 2], &a[4 * i + 2], &b[4 * i + 2], -PQCLEAN_MLKEM512_CLEAN_zetas[64 + i]);
+        }
+        PQCLEAN_MLKEM512_CLEAN_basemul_avx2(got, a, b);
+        failures += check("basemul", n, got, want);
+
+        random_poly(a);
+        memcpy(got, a, sizeof(a));
+        for (i = 0; i < 256; i++) {
+            want[i] = PQCLEAN_MLKEM512_CLEAN_barrett_reduce(a[i]);
+        }
+        PQCLEAN_MLKEM512_CLEAN_reduce_avx2(got);
+        failures += check("reduce", n, got, want);
+
+        if (failures > 0) {
+            return 1;
+        }
+    }
+    printf("%u random inputs per kernel: identical\n", ITERATIONS);
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("AVX2 kernels not built: skipped\n");
+    return TEST_SKIPPED;
+}
+
+#endif
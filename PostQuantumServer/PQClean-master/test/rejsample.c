@@ -0,0 +1,144 @@
+/*
+ * AVX2 rejection samplers (rejsample_avx2.c of ML-KEM-512 and ML-DSA-44)
+ * against the portable rej_uniform of each scheme. Both the returned count
+ * and the sampled values must agree, and the AVX2 version must not write
+ * past len. Covered tails:
+ *   - every buflen up to 128 with every len up to 40, which includes
+ *     buflen < 32 where only the scalar loop runs,
+ *   - len not a multiple of 8 / 16 and len reached in the middle of a
+ *     24-byte block,
+ *   - buflen not a multiple of 3 or 24, with buffers that reject often.
+ * Skipped without AVX2.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../crypto_kem/ml-kem-512/clean/params.h"
+#include "../crypto_kem/ml-kem-512/clean/rejsample.h"
+#include "../crypto_sign/ml-dsa-44/clean/params.h"
+#include "../crypto_sign/ml-dsa-44/clean/rejsample.h"
+#include "testrng.h"
+
+#define MAX_LEN 256
+#define MAX_BUFLEN 1024
+/* Slack past len that the AVX2 sampler must leave alone */
+#define GUARD 32
+#define RANDOM_CASES 200000
+
+#if defined(PQCLEAN_MLKEM512_CLEAN_NTT_AVX2) && defined(PQCLEAN_MLDSA44_CLEAN_NTT_AVX2)
+
+static uint8_t buf[MAX_BUFLEN];
+
+/*
+ * Random input; in "harsh" mode most bytes are 0xFF, so that most
+ * candidates are rejected and the vector loop compacts sparse masks.
+ */
+static void random_buf(unsigned int buflen, int harsh) {
+    unsigned int i;
+
+    test_rand_bytes(buf, buflen);
+    if (harsh) {
+        for (i = 0; i < buflen; i++) {
+            if (test_rand_below(4) != 0) {
+                buf[i] = 0xFF;
+            }
+        }
+    }
+}
+
+static int check_kem(unsigned int len, unsigned int buflen) {
+    int16_t want[MAX_LEN + GUARD], got[MAX_LEN + GUARD];
+    unsigned int want_ctr, got_ctr, i;
+
+    memset(want, 0x5A, sizeof(want));
+    memset(got, 0x5A, sizeof(got));
+    want_ctr = PQCLEAN_MLKEM512_CLEAN_rej_uniform(want, len, buf, buflen);
+    got_ctr = PQCLEAN_MLKEM512_CLEAN_rej_uniform_avx2(got, len, buf, buflen);
+    if (got_ctr != want_ctr) {
+        fprintf(stderr, "ml-kem: len %u, buflen %u: avx2 returned %u, clean %u\n",
+                len, buflen, got_ctr, want_ctr);
+        return 1;
+    }
+    if (memcmp(got, want, want_ctr * sizeof(int16_t)) != 0) {
+        fprintf(stderr, "ml-kem: len %u, buflen %u: sampled values differ\n", len, buflen);
+        return 1;
+    }
+    for (i = len; i < MAX_LEN + GUARD; i++) {
+        if (got[i] != want[i]) {
+            fprintf(stderr, "ml-kem: len %u, buflen %u: avx2 wrote r[%u]\n", len, buflen, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_dsa(unsigned int len, unsigned int buflen) {
+    int32_t want[MAX_LEN + GUARD], got[MAX_LEN + GUARD];
+    unsigned int want_ctr, got_ctr, i;
+
+    memset(want, 0x5A, sizeof(want));
+    memset(got, 0x5A, sizeof(got));
+    want_ctr = PQCLEAN_MLDSA44_CLEAN_rej_uniform(want, len, buf, buflen);
+    got_ctr = PQCLEAN_MLDSA44_CLEAN_rej_uniform_avx2(got, len, buf, buflen);
+    if (got_ctr != want_ctr) {
+        fprintf(stderr, "ml-dsa: len %u, buflen %u: avx2 returned %u, clean %u\n",
+                len, buflen, got_ctr, want_ctr);
+        return 1;
+    }
+    if (memcmp(got, want, want_ctr * sizeof(int32_t)) != 0) {
+        fprintf(stderr, "ml-dsa: len %u, buflen %u: sampled values differ\n", len, buflen);
+        return 1;
+    }
+    for (i = len; i < MAX_LEN + GUARD; i++) {
+        if (got[i] != want[i]) {
+            fprintf(stderr, "ml-dsa: len %u, buflen %u: avx2 wrote a[%u]\n", len, buflen, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    unsigned int len, buflen, n;
+    int harsh;
+
+    if (!PQCLEAN_MLKEM512_CLEAN_avx2_available()) {
+        printf("AVX2 not available: skipped\n");
+        return TEST_SKIPPED;
+    }
+
+    /* Exhaustive small shapes: short buffers, short and odd lengths */
+    for (harsh = 0; harsh <= 1; harsh++) {
+        for (buflen = 0; buflen <= 128; buflen++) {
+            for (len = 0; len <= 40; len++) {
+                random_buf(buflen, harsh);
+                if (check_kem(len, buflen) || check_dsa(len, buflen)) {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    /* Random shapes up to the sizes gen_matrix and poly_uniform use */
+    for (n = 0; n < RANDOM_CASES; n++) {
+        len = test_rand_below(MAX_LEN + 1);
+        buflen = test_rand_below(MAX_BUFLEN + 1);
+        random_buf(buflen, (int)(n & 1));
+        if (check_kem(len, buflen) || check_dsa(len, buflen)) {
+            return 1;
+        }
+    }
+    printf("%u random shapes and all small shapes: identical\n", RANDOM_CASES);
+    return 0;
+}
+
+#else
+
+int main(void) {
+    printf("AVX2 samplers not built: skipped\n");
+    return TEST_SKIPPED;
+}
+
+#endif
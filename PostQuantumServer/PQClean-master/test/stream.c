@@ -0,0 +1,151 @@
+/*
+ * ML-DSA-44 streaming API: crypto_sign_signature_init/_update/_final must
+ * produce the same bytes as crypto_sign_signature_ctx over the whole
+ * message, however the message is cut into updates (single bytes, odd
+ * sizes around the SHAKE256 rate, empty updates). randombytes is replaced
+ * by the fixed-seed test generator, and the generator is rewound before
+ * each signature so both paths draw the same hedging randomness.
+ * Signatures must also verify across the two APIs, and a context string
+ * longer than 255 bytes must be refused by both init functions.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../crypto_sign/ml-dsa-44/clean/api.h"
+#include "randombytes.h"
+#include "testrng.h"
+
+#define DSA_PK PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES
+#define DSA_SK PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES
+#define DSA_SIG PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES
+#define MAX_MLEN 3001
+
+/* Replaces the system generator of common/randombytes.c */
+int randombytes(uint8_t *output, size_t n) {
+    test_rand_bytes(output, n);
+    return 0;
+}
+
+/* Message lengths: empty, short, around the SHAKE256 rate (136) and long */
+static const size_t MLENS[] = { 0, 1, 135, 136, 137, 1000, MAX_MLEN };
+static const size_t CTXLENS[] = { 0, 17, 255 };
+/* Update sizes; 0 means alternate 7-byte and empty updates */
+static const size_t CHUNKS[] = { MAX_MLEN, 1, 3, 7, 135, 136, 137, 0 };
+
+static uint8_t pk[DSA_PK], sk[DSA_SK];
+static uint8_t msg[MAX_MLEN];
+static uint8_t ctx[255];
+
+/* Feeds m in pieces of chunk bytes, with an empty update first and last */
+static void feed(void (*update)(PQCLEAN_MLDSA44_CLEAN_sign_stream *, const uint8_t *, size_t),
+                 PQCLEAN_MLDSA44_CLEAN_sign_stream *stream, const uint8_t *m, size_t mlen, size_t chunk) {
+    size_t pos = 0, n;
+    int empty = 1;
+
+    update(stream, m, 0);
+    while (pos < mlen) {
+        if (chunk == 0) {
+            n = empty ? 0 : 7;
+            empty = !empty;
+        } else {
+            n = chunk;
+        }
+        if (n > mlen - pos) {
+            n = mlen - pos;
+        }
+        update(stream, m + pos, n);
+        pos += n;
+    }
+    update(stream, m + pos, 0);
+}
+
+static int check(size_t mlen, size_t ctxlen, size_t chunk) {
+    PQCLEAN_MLDSA44_CLEAN_sign_stream stream;
+    uint8_t want[DSA_SIG], got[DSA_SIG];
+    size_t wantlen, gotlen;
+    uint64_t seed = test_rng_state;
+
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_ctx(want, &wantlen, msg, mlen, ctx, ctxlen, sk) != 0) {
+        fprintf(stderr, "mlen %zu, ctxlen %zu: signature_ctx failed\n", mlen, ctxlen);
+        return 1;
+    }
+
+    test_rng_state = seed;
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_init(&stream, ctx, ctxlen, sk) != 0) {
+        fprintf(stderr, "mlen %zu, ctxlen %zu: signature_init failed\n", mlen, ctxlen);
+        return 1;
+    }
+    feed(PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_update, &stream, msg, mlen, chunk);
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_final(got, &gotlen, &stream, sk) != 0 ||
+            gotlen != wantlen || memcmp(got, want, DSA_SIG) != 0) {
+        fprintf(stderr, "mlen %zu, ctxlen %zu, chunk %zu: streamed signature differs\n", mlen, ctxlen, chunk);
+        return 1;
+    }
+
+    /* Streamed signature, one-shot verification */
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_ctx(got, gotlen, msg, mlen, ctx, ctxlen, pk) != 0) {
+        fprintf(stderr, "mlen %zu, ctxlen %zu, chunk %zu: verify_ctx rejected the streamed signature\n",
+                mlen, ctxlen, chunk);
+        return 1;
+    }
+
+    /* One-shot signature, streamed verification */
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_init(&stream, ctx, ctxlen, pk) != 0) {
+        fprintf(stderr, "mlen %zu, ctxlen %zu: verify_init failed\n", mlen, ctxlen);
+        return 1;
+    }
+    feed(PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_update, &stream, msg, mlen, chunk);
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_final(want, wantlen, &stream, pk) != 0) {
+        fprintf(stderr, "mlen %zu, ctxlen %zu, chunk %zu: streamed verification rejected the signature\n",
+                mlen, ctxlen, chunk);
+        return 1;
+    }
+
+    /* A changed message must fail the streamed verification */
+    if (mlen > 0) {
+        msg[mlen / 2] ^= 0x01;
+        PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_init(&stream, ctx, ctxlen, pk);
+        feed(PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_update, &stream, msg, mlen, chunk);
+        msg[mlen / 2] ^= 0x01;
+        if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_final(want, wantlen, &stream, pk) == 0) {
+            fprintf(stderr, "mlen %zu, ctxlen %zu, chunk %zu: streamed verification accepted a changed message\n",
+                    mlen, ctxlen, chunk);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    PQCLEAN_MLDSA44_CLEAN_sign_stream stream;
+    uint8_t long_ctx[256] = { 0 };
+    size_t m, c, k;
+    unsigned int cases = 0;
+
+    PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(pk, sk);
+    test_rand_bytes(msg, sizeof(msg));
+    test_rand_bytes(ctx, sizeof(ctx));
+
+    for (m = 0; m < sizeof(MLENS) / sizeof(MLENS[0]); m++) {
+        for (c = 0; c < sizeof(CTXLENS) / sizeof(CTXLENS[0]); c++) {
+            for (k = 0; k < sizeof(CHUNKS) / sizeof(CHUNKS[0]); k++) {
+                if (check(MLENS[m], CTXLENS[c], CHUNKS[k])) {
+                    return 1;
+                }
+                cases++;
+            }
+        }
+    }
+
+    if (PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_init(&stream, long_ctx, sizeof(long_ctx), sk) != -1 ||
+            PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_init(&stream, long_ctx, sizeof(long_ctx), pk) != -1) {
+        fprintf(stderr, "init accepted a %zu-byte context string\n", sizeof(long_ctx));
+        return 1;
+    }
+
+    printf("%u chunkings: streamed signatures identical to signature_ctx\n", cases);
+    return 0;
+}
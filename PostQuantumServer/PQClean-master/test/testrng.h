@@ -0,0 +1,41 @@
+#ifndef PQCLEAN_TEST_TESTRNG_H
+#define PQCLEAN_TEST_TESTRNG_H
+
+/*
+ * Fixed-seed generator (splitmix64) for the kernel equivalence tests, so a
+ * failure reproduces on every run. Not for key material.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exit code that makes ctest report a test as skipped (SKIP_RETURN_CODE) */
+#define TEST_SKIPPED 77
+
+static uint64_t test_rng_state = 0x243F6A8885A308D3ULL;
+
+static inline uint64_t test_rand64(void) {
+    uint64_t z = (test_rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Uniform in [0, bound) (bound > 0; the bias is irrelevant for testing) */
+static inline uint32_t test_rand_below(uint32_t bound) {
+    return (uint32_t)(test_rand64() % bound);
+}
+
+static inline void test_rand_bytes(uint8_t *out, size_t len) {
+    size_t i;
+    uint64_t z = 0;
+
+    for (i = 0; i < len; i++) {
+        if (i % 8 == 0) {
+            z = test_rand64();
+        }
+        out[i] = (uint8_t)(z >> (8 * (i % 8)));
+    }
+}
+
+#endif
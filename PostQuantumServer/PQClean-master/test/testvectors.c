@@ -0,0 +1,106 @@
+/*
+ * Deterministic ML-KEM-512 and ML-DSA-44 outputs, one SHAKE256 digest per
+ * iteration. randombytes is replaced by a fixed-seed generator, so the
+ * output depends only on the code paths taken. The test suite builds this
+ * program twice, against the default libraries (AVX2 NTT kernels, AVX2
+ * samplers and the 4-way Keccak when the CPU has AVX2) and against
+ * libraries built with PQCLEAN_NO_AVX2, and requires identical output.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../crypto_kem/ml-kem-512/clean/api.h"
+#include "../crypto_sign/ml-dsa-44/clean/api.h"
+#include "fips202.h"
+#include "randombytes.h"
+
+#define ITERATIONS 32
+#define MAX_MLEN 128
+
+#define KEM_PK PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES
+#define KEM_SK PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES
+#define KEM_CT PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES
+#define KEM_SS PQCLEAN_MLKEM512_CLEAN_CRYPTO_BYTES
+#define DSA_PK PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES
+#define DSA_SK PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES
+#define DSA_SIG PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES
+
+static uint64_t rng_state = 0x243F6A8885A308D3ULL;
+
+/* splitmix64; replaces the system generator of common/randombytes.c */
+int randombytes(uint8_t *output, size_t n) {
+    size_t i;
+    uint64_t z = 0;
+
+    for (i = 0; i < n; i++) {
+        if (i % 8 == 0) {
+            z = (rng_state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+        }
+        output[i] = (uint8_t)(z >> (8 * (i % 8)));
+    }
+    return 0;
+}
+
+static void print_digest(unsigned int iteration, const uint8_t *data, size_t len) {
+    uint8_t digest[32];
+    size_t i;
+
+    shake256(digest, sizeof(digest), data, len);
+    printf("%u ", iteration);
+    for (i = 0; i < sizeof(digest); i++) {
+        printf("%02x", digest[i]);
+    }
+    printf("\n");
+}
+
+int main(void) {
+    /* Everything one iteration produces, hashed into one line */
+    static uint8_t out[KEM_PK + KEM_SK + KEM_CT + 2 * KEM_SS + DSA_PK + DSA_SK + DSA_SIG];
+    uint8_t *kem_pk = out;
+    uint8_t *kem_sk = kem_pk + KEM_PK;
+    uint8_t *kem_ct = kem_sk + KEM_SK;
+    uint8_t *kem_ss = kem_ct + KEM_CT;
+    uint8_t *kem_ss_bad = kem_ss + KEM_SS;
+    uint8_t *dsa_pk = kem_ss_bad + KEM_SS;
+    uint8_t *dsa_sk = dsa_pk + DSA_PK;
+    uint8_t *dsa_sig = dsa_sk + DSA_SK;
+    uint8_t ss[KEM_SS];
+    uint8_t m[MAX_MLEN];
+    size_t siglen, mlen;
+    unsigned int i;
+
+    for (i = 0; i < ITERATIONS; i++) {
+        /* ML-KEM: key generation, encapsulation, decapsulation of the genuine
+         * ciphertext and of a corrupted one (implicit rejection) */
+        PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(kem_pk, kem_sk);
+        PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(kem_ct, kem_ss, kem_pk);
+        PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(ss, kem_ct, kem_sk);
+        if (memcmp(ss, kem_ss, KEM_SS) != 0) {
+            fprintf(stderr, "iteration %u: ML-KEM shared secrets differ\n", i);
+            return 1;
+        }
+        kem_ct[i % KEM_CT] ^= 0x01;
+        PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(kem_ss_bad, kem_ct, kem_sk);
+        kem_ct[i % KEM_CT] ^= 0x01;
+
+        /* ML-DSA: key generation and a (randomized) signature */
+        mlen = (i * 7) % MAX_MLEN;
+        randombytes(m, mlen);
+        PQCLEAN_MLDSA44_CLEAN_crypto_sign_keypair(dsa_pk, dsa_sk);
+        PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature(dsa_sig, &siglen, m, mlen, dsa_sk);
+        if (siglen != DSA_SIG ||
+                PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify(dsa_sig, siglen, m, mlen, dsa_pk) != 0) {
+            fprintf(stderr, "iteration %u: ML-DSA signature does not verify\n", i);
+            return 1;
+        }
+
+        print_digest(i, out, sizeof(out));
+    }
+    return 0;
+}
@@ -0,0 +1,791 @@
+// PostQuantumLoad.cpp
+/**
+ * @file PostQuantumLoad.cpp
+ * @brief Closed‑loop load generator that plays thousands of firmware devices against the server.
+ *
+ * Usage: PostQuantumLoad [--host ADDR] [--port N] [--devices N] [--threads N]
+ *                        [--duration S] [--warmup S] [--timeout MS]
+ *                        [--flow kem|auth|both] [--binary] [--no-verify]
+ *
+ * Every simulated device runs the same exchange as Quantum‑Experiment's
+ * connectToServer(), without its delays: connect, optionally switch to
+ * binary frames, AuthRequest → verify AuthReply → Ack ("auth"), and
+ * KemRequest → encapsulate to the KemInit key → KemCipher →
+ * ConfidentialData under AES‑256‑CTR ("kem", the firmware's default
+ * build). The device then half‑closes and waits for the server to close, so
+ * a handshake's latency runs from connect() to the server's close and
+ * includes its decapsulation and decryption. The device reconnects at once
+ * (closed loop), so --devices is the number of concurrent handshakes.
+ *
+ * Handshakes finished during --warmup are not counted. The report gives
+ * handshakes per second over --duration and the 50th/99th/99.9th
+ * percentile latency. AuthReply signatures are checked against
+ * PublicKeyDilithium.txt in the working directory unless --no-verify is
+ * given. The generator shares the machine with the server when run against
+ * localhost; pin both (taskset) to keep the numbers comparable.
+ */
+
+ // POSIX socket / epoll headers
+#include <sys/epoll.h>
+#include <sys/resource.h>  ///< for setrlimit()
+#include <sys/socket.h>
+#include <netdb.h>         ///< for getaddrinfo()
+#include <netinet/in.h>
+#include <netinet/tcp.h>   ///< for TCP_NODELAY
+#include <unistd.h>
+#include <cerrno>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Helpers.hpp"
+#include "Protocol.hpp"
+
+extern "C" {
+#include "PQClean-master/crypto_sign/ml-dsa-44/clean/api.h"   ///< ML-DSA verification
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/api.h"   ///< ML-KEM encapsulation
+#include "aes.h"                                             ///< AES‑256‑CTR
+#include "randombytes.h"                                     ///< IV generation
+}
+
+using namespace std;
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+/// The firmware's ConfidentialData message
+constexpr char PLAINTEXT[] = "Post-Quantum Cryptography is Awesome.";
+constexpr size_t PLAINTEXT_LEN = sizeof(PLAINTEXT) - 1;
+/// recv() chunk; a hex AuthReply is about 4.9 KB
+constexpr size_t READ_CHUNK = 8192;
+/// Longest reply accepted before the separator / frame header shows up
+constexpr size_t MAX_REPLY = 2 * PROTO_MAX_PAYLOAD + 64;
+constexpr int MAX_EVENTS = 256;
+/// How often idle devices and timeouts are checked
+constexpr chrono::milliseconds TICK(50);
+/// Pause before a device retries after a failed handshake
+constexpr chrono::milliseconds RETRY_DELAY(100);
+
+/**
+ * @brief Command‑line settings shared by all load threads.
+ */
+struct LoadConfig {
+	string host = "127.0.0.1";
+	string port = "8080";
+	size_t devices = 1000;
+	size_t threads = 1;
+	double durationS = 10.0;
+	double warmupS = 1.0;
+	int timeoutMs = 10000;
+	bool auth = false;      ///< AuthRequest / AuthReply / Ack
+	bool kem = true;        ///< KemRequest / KemInit / KemCipher / ConfidentialData
+	bool binary = false;    ///< Negotiate binary frames first
+	bool verify = true;     ///< Check AuthReply signatures like the firmware
+};
+
+/**
+ * @brief Where a device is in its handshake.
+ */
+enum class Step {
+	Idle,        ///< No connection; waiting to (re)connect
+	Connecting,  ///< Non‑blocking connect() in progress
+	Hello,       ///< Waiting for the binary version byte
+	AuthReply,   ///< Waiting for the signed AuthReply
+	KemInit,     ///< Waiting for the KEM public key
+	Draining     ///< All sent; waiting for the server to close
+};
+
+/**
+ * @brief Why a handshake did not complete.
+ */
+enum Failure { FailConnect, FailProtocol, FailSignature, FailTimeout, FailDropped, FAILURE_KINDS };
+const char* const FAILURE_NAMES[FAILURE_KINDS] = { "connect", "protocol", "signature", "timeout", "dropped" };
+
+/**
+ * @brief One simulated device.
+ */
+struct Device {
+	int fd = -1;
+	Step step = Step::Idle;
+	bool halfClosed = false;
+	Clock::time_point started;   ///< connect() of the current handshake
+	Clock::time_point retryAt;   ///< earliest next connect() while Idle
+	string in;
+	string out;
+};
+
+/**
+ * @brief What one load thread measured; read by main() after join().
+ */
+struct ThreadStats {
+	atomic<uint64_t> completed{ 0 };         ///< All handshakes, for the progress line
+	uint64_t failures[FAILURE_KINDS] = {};   ///< Inside the measured window
+	vector<uint32_t> latencyUs;              ///< Inside the measured window
+};
+
+/**
+ * @brief An epoll loop driving its share of the devices.
+ */
+class LoadThread {
+public:
+	LoadThread(const LoadConfig& config, const sockaddr_storage& addr, socklen_t addrLen,
+		const PQCLEAN_MLDSA44_CLEAN_verifier* verifier, size_t devices,
+		Clock::time_point measureStart, Clock::time_point measureEnd, const atomic<bool>& stop)
+		: config(config), addr(addr), addrLen(addrLen), verifier(verifier), devices(devices),
+		measureStart(measureStart), measureEnd(measureEnd), stop(stop) {
+	}
+	~LoadThread() {
+		for (Device& device : devices) {
+			if (device.fd >= 0) {
+				close(device.fd);
+			}
+		}
+		if (epollFd >= 0) {
+			close(epollFd);
+		}
+	}
+
+	/**
+	 * @brief Connect every device and keep them busy until stop is set.
+	 */
+	void run() {
+		epollFd = epoll_create1(EPOLL_CLOEXEC);
+		if (epollFd < 0) {
+			cerr << "Error: epoll_create1() failed. Code: " << errno << endl;
+			return;
+		}
+		for (Device& device : devices) {
+			start(device);
+		}
+		epoll_event events[MAX_EVENTS];
+		Clock::time_point nextTick = Clock::now() + TICK;
+		while (!stop.load(memory_order_relaxed)) {
+			int n = epoll_wait(epollFd, events, MAX_EVENTS, static_cast<int>(TICK.count()));
+			if (n < 0 && errno != EINTR) {
+				cerr << "Error: epoll_wait() failed. Code: " << errno << endl;
+				return;
+			}
+			for (int i = 0; i < n; ++i) {
+				handleEvent(devices[events[i].data.u64], events[i].events);
+			}
+			// Reconnect only after the batch: a new socket must not see the old one's events
+			for (size_t index : restart) {
+				start(devices[index]);
+			}
+			restart.clear();
+			Clock::time_point now = Clock::now();
+			if (now >= nextTick) {
+				checkDevices(now);
+				nextTick = now + TICK;
+			}
+		}
+	}
+
+	ThreadStats& statistics() { return stats; }
+
+private:
+	const LoadConfig& config;
+	sockaddr_storage addr;
+	socklen_t addrLen;
+	const PQCLEAN_MLDSA44_CLEAN_verifier* verifier;
+	vector<Device> devices;
+	vector<size_t> restart;
+	Clock::time_point measureStart;
+	Clock::time_point measureEnd;
+	const atomic<bool>& stop;
+	int epollFd = -1;
+	ThreadStats stats;
+
+	size_t indexOf(const Device& device) const { return static_cast<size_t>(&device - devices.data()); }
+
+	bool inWindow(Clock::time_point t) const { return t >= measureStart && t < measureEnd; }
+
+	/**
+	 * @brief Open a non‑blocking connection for an idle device.
+	 */
+	void start(Device& device) {
+		device.started = Clock::now();
+		device.fd = socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (device.fd < 0) {
+			fail(device, FailConnect);
+			return;
+		}
+		int one = 1;
+		setsockopt(device.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		// Reset on close: thousands of handshakes per second would otherwise
+		// exhaust the ephemeral ports with TIME_WAIT sockets
+		linger abortive{ 1, 0 };
+		setsockopt(device.fd, SOL_SOCKET, SO_LINGER, &abortive, sizeof(abortive));
+
+		// Edge‑triggered: read until EAGAIN, write until EAGAIN, no interest changes
+		epoll_event ev{};
+		ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+		ev.data.u64 = indexOf(device);
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, device.fd, &ev) < 0) {
+			fail(device, FailConnect);
+			return;
+		}
+		device.step = Step::Connecting;
+		if (connect(device.fd, reinterpret_cast<const sockaddr*>(&addr), addrLen) == 0) {
+			connected(device);
+		}
+		else if (errno != EINPROGRESS) {
+			fail(device, FailConnect);
+		}
+	}
+
+	void handleEvent(Device& device, uint32_t events) {
+		if (device.step == Step::Idle) {
+			return;   // stale event of a closed socket
+		}
+		if (device.step == Step::Connecting) {
+			int error = 0;
+			socklen_t len = sizeof(error);
+			if (getsockopt(device.fd, SOL_SOCKET, SO_ERROR, &error, &len) < 0 || error != 0) {
+				fail(device, FailConnect);
+				return;
+			}
+			if (!(events & EPOLLOUT)) {
+				return;
+			}
+			connected(device);
+			if (device.step == Step::Idle) {
+				return;
+			}
+		}
+		if ((events & EPOLLOUT) && !flush(device)) {
+			return;
+		}
+		if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+			receive(device);
+		}
+	}
+
+	void connected(Device& device) {
+		if (config.binary) {
+			device.out.push_back(static_cast<char>(PROTO_BINARY_MAGIC | PROTO_BINARY_VERSION));
+			device.step = Step::Hello;
+			flush(device);
+			return;
+		}
+		beginFlow(device);
+	}
+
+	/**
+	 * @brief Send the first request of the configured flow.
+	 */
+	void beginFlow(Device& device) {
+		if (config.auth) {
+			sendRequest(device, FrameType::AuthRequest, "AuthRequest");
+			device.step = Step::AuthReply;
+		}
+		else {
+			sendRequest(device, FrameType::KemRequest, "KemRequest");
+			device.step = Step::KemInit;
+		}
+		flush(device);
+	}
+
+	/**
+	 * @brief Read until EAGAIN and advance the handshake on every reply.
+	 */
+	void receive(Device& device) {
+		while (device.step != Step::Idle) {
+			size_t at = device.in.size();
+			device.in.resize(at + READ_CHUNK);
+			ssize_t n = recv(device.fd, device.in.data() + at, READ_CHUNK, 0);
+			device.in.resize(at + (n > 0 ? static_cast<size_t>(n) : 0));
+			if (n < 0) {
+				if (errno == EINTR) continue;
+				if (errno != EAGAIN && errno != EWOULDBLOCK) {
+					fail(device, FailDropped);
+				}
+				return;
+			}
+			if (n == 0) {
+				if (device.step == Step::Draining) {
+					finish(device);
+				}
+				else {
+					fail(device, FailDropped);
+				}
+				return;
+			}
+			while (device.step != Step::Idle && advance(device)) {
+			}
+		}
+	}
+
+	/**
+	 * @brief Consume one complete reply, if buffered.
+	 * @return True if the device moved on and may have more to consume.
+	 */
+	bool advance(Device& device) {
+		switch (device.step) {
+		case Step::Hello:
+			if (device.in.empty()) {
+				return false;
+			}
+			if (static_cast<uint8_t>(device.in[0]) != (PROTO_BINARY_MAGIC | PROTO_BINARY_VERSION)) {
+				fail(device, FailProtocol);
+				return false;
+			}
+			device.in.erase(0, 1);
+			beginFlow(device);
+			return true;
+		case Step::AuthReply:
+			return onAuthReply(device);
+		case Step::KemInit:
+			return onKemInit(device);
+		case Step::Draining:
+			// The server sends nothing after the last request
+			device.in.clear();
+			return false;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * @brief Mirror of the firmware's processAuthReply(): verify, then Ack.
+	 */
+	bool onAuthReply(Device& device) {
+		const uint8_t* message;
+		size_t messageLen;
+		const uint8_t* signature;
+		size_t consumed;
+		uint8_t sigBytes[PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES];
+		if (config.binary) {
+			// Payload: message || signature
+			Frame frame;
+			FrameStatus status = decodeFrame(reinterpret_cast<const uint8_t*>(device.in.data()),
+				device.in.size(), frame, consumed);
+			if (status == FrameStatus::Incomplete) {
+				return false;
+			}
+			if (status == FrameStatus::Invalid || frame.type != FrameType::AuthReply
+				|| frame.length < PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES) {
+				fail(device, FailProtocol);
+				return false;
+			}
+			message = frame.payload;
+			messageLen = frame.length - PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
+			signature = frame.payload + messageLen;
+		}
+		else {
+			// "AuthReply:<timestamp>|signature:<hex>", no line terminator
+			const char separator[] = "|signature:";
+			size_t sep = device.in.find(separator);
+			if (sep == string::npos) {
+				if (device.in.size() > MAX_REPLY) {
+					fail(device, FailProtocol);
+				}
+				return false;
+			}
+			size_t hexAt = sep + sizeof(separator) - 1;
+			consumed = hexAt + 2 * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
+			if (device.in.size() < consumed) {
+				return false;
+			}
+			if (device.in.compare(0, 10, "AuthReply:") != 0
+				|| !hexToBytes(string_view(device.in).substr(hexAt, consumed - hexAt), span<uint8_t>(sigBytes))) {
+				fail(device, FailProtocol);
+				return false;
+			}
+			message = reinterpret_cast<const uint8_t*>(device.in.data());
+			messageLen = sep;
+			signature = sigBytes;
+		}
+		if (verifier && PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify_verifier(signature,
+			PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES, message, messageLen, nullptr, 0, verifier) != 0) {
+			fail(device, FailSignature);
+			return false;
+		}
+		device.in.erase(0, consumed);
+
+		sendRequest(device, FrameType::Ack, "Ack");
+		if (config.kem) {
+			sendRequest(device, FrameType::KemRequest, "KemRequest");
+			device.step = Step::KemInit;
+		}
+		else {
+			device.step = Step::Draining;
+		}
+		return flush(device);
+	}
+
+	/**
+	 * @brief Mirror of the firmware's processKem() and AES block: encapsulate, send
+	 *        KemCipher, then the encrypted ConfidentialData right behind it.
+	 */
+	bool onKemInit(Device& device) {
+		uint8_t pk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES];
+		size_t consumed;
+		if (config.binary) {
+			Frame frame;
+			FrameStatus status = decodeFrame(reinterpret_cast<const uint8_t*>(device.in.data()),
+				device.in.size(), frame, consumed);
+			if (status == FrameStatus::Incomplete) {
+				return false;
+			}
+			if (status == FrameStatus::Invalid || frame.type != FrameType::KemInit || frame.length != sizeof(pk)) {
+				fail(device, FailProtocol);
+				return false;
+			}
+			memcpy(pk, frame.payload, sizeof(pk));
+		}
+		else {
+			// "KemInit:<1600 hex>", no line terminator
+			const char prefix[] = "KemInit:";
+			size_t hexAt = sizeof(prefix) - 1;
+			consumed = hexAt + 2 * sizeof(pk);
+			if (device.in.size() < consumed) {
+				return false;
+			}
+			if (device.in.compare(0, hexAt, prefix) != 0
+				|| !hexToBytes(string_view(device.in).substr(hexAt, 2 * sizeof(pk)), span<uint8_t>(pk))) {
+				fail(device, FailProtocol);
+				return false;
+			}
+		}
+		device.in.erase(0, consumed);
+
+		uint8_t ct[PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES];
+		uint8_t ss[PQCLEAN_MLKEM512_CLEAN_CRYPTO_BYTES];
+		if (PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(ct, ss, pk) != 0) {
+			fail(device, FailProtocol);
+			return false;
+		}
+		if (config.binary) {
+			appendFrame(device.out, FrameType::KemCipher, ct, sizeof(ct));
+		}
+		else {
+			device.out.append("KemCipher:");
+			appendHex(device.out, ct, sizeof(ct));
+			device.out.append("\r\n");
+		}
+
+		// AES‑256‑CTR under the shared secret with a fresh 12‑byte IV
+		uint8_t payload[AESCTR_NONCEBYTES + PLAINTEXT_LEN];
+		uint8_t* iv = payload;
+		uint8_t* data = payload + AESCTR_NONCEBYTES;
+		aes256ctx aes;
+		aes256_ctr_keyexp(&aes, ss);
+		secureZero(ss, sizeof(ss));
+		randombytes(iv, AESCTR_NONCEBYTES);
+		aes256_ctr(data, PLAINTEXT_LEN, iv, &aes);
+		aes256_ctx_release(&aes);
+		for (size_t i = 0; i < PLAINTEXT_LEN; ++i) {
+			data[i] ^= static_cast<uint8_t>(PLAINTEXT[i]);
+		}
+		if (config.binary) {
+			appendFrame(device.out, FrameType::ConfidentialData, payload, sizeof(payload));
+		}
+		else {
+			device.out.append("ConfidentialData:");
+			appendHex(device.out, iv, AESCTR_NONCEBYTES);
+			device.out.push_back(':');
+			appendHex(device.out, data, PLAINTEXT_LEN);
+			device.out.append("\r\n");
+		}
+		device.step = Step::Draining;
+		return flush(device);
+	}
+
+	static void appendHex(string& out, const uint8_t* data, size_t size) {
+		size_t at = out.size();
+		out.resize(at + 2 * size);
+		bytesToHex(span<const uint8_t>(data, size), span<char>(out.data() + at, 2 * size));
+	}
+
+	/**
+	 * @brief Queue a request without payload ("AuthRequest", "KemRequest", "Ack").
+	 */
+	void sendRequest(Device& device, FrameType type, const char* verb) {
+		if (config.binary) {
+			appendFrame(device.out, type, nullptr, 0);
+		}
+		else {
+			// The firmware uses println()
+			device.out.append(verb);
+			device.out.append("\r\n");
+		}
+	}
+
+	/**
+	 * @brief Send queued output; half‑close once a draining device has sent it all.
+	 * @return False if the device failed.
+	 */
+	bool flush(Device& device) {
+		size_t sent = 0;
+		while (sent < device.out.size()) {
+			ssize_t n = send(device.fd, device.out.data() + sent, device.out.size() - sent, MSG_NOSIGNAL);
+			if (n < 0) {
+				if (errno == EINTR) continue;
+				if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+				fail(device, FailDropped);
+				return false;
+			}
+			sent += static_cast<size_t>(n);
+		}
+		device.out.erase(0, sent);
+		// Like the firmware's client.stop(): the server sees EOF and closes its side
+		if (device.out.empty() && device.step == Step::Draining && !device.halfClosed) {
+			shutdown(device.fd, SHUT_WR);
+			device.halfClosed = true;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief The server closed after the last request: record the handshake.
+	 */
+	void finish(Device& device) {
+		Clock::time_point now = Clock::now();
+		if (inWindow(now)) {
+			auto us = chrono::duration_cast<chrono::microseconds>(now - device.started).count();
+			stats.latencyUs.push_back(static_cast<uint32_t>(us));
+		}
+		stats.completed.fetch_add(1, memory_order_relaxed);
+		reset(device);
+		device.retryAt = now;
+		restart.push_back(indexOf(device));
+	}
+
+	void fail(Device& device, Failure why) {
+		Clock::time_point now = Clock::now();
+		if (inWindow(now)) {
+			stats.failures[why]++;
+		}
+		reset(device);
+		device.retryAt = now + RETRY_DELAY;
+	}
+
+	void reset(Device& device) {
+		if (device.fd >= 0) {
+			close(device.fd);   // also leaves the epoll set
+			device.fd = -1;
+		}
+		device.step = Step::Idle;
+		device.halfClosed = false;
+		device.in.clear();
+		device.out.clear();
+	}
+
+	/**
+	 * @brief Retry failed devices whose delay is over; time out stuck handshakes.
+	 */
+	void checkDevices(Clock::time_point now) {
+		auto timeout = chrono::milliseconds(config.timeoutMs);
+		for (Device& device : devices) {
+			if (device.step == Step::Idle) {
+				if (now >= device.retryAt) {
+					start(device);
+				}
+			}
+			else if (now - device.started > timeout) {
+				fail(device, FailTimeout);
+			}
+		}
+	}
+};
+
+/**
+ * @brief Nearest‑rank percentile of sorted values.
+ */
+double percentile(const vector<uint32_t>& sorted, double p) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	size_t rank = static_cast<size_t>(ceil(p / 100.0 * static_cast<double>(sorted.size())));
+	return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+/**
+ * @brief Lift the descriptor limit to the hard maximum: one socket per device.
+ */
+void raiseFileLimit(size_t devices) {
+	rlimit limit{};
+	if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+		return;
+	}
+	if (limit.rlim_cur < limit.rlim_max) {
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+	if (limit.rlim_cur != RLIM_INFINITY && devices + 64 > limit.rlim_cur) {
+		cerr << "Warning: " << devices << " devices need more descriptors than the limit of "
+			<< limit.rlim_cur << "." << endl;
+	}
+}
+
+void printUsage(const char* program) {
+	cerr << "Usage: " << program << " [--host ADDR] [--port N] [--devices N] [--threads N]\n"
+		<< "       [--duration S] [--warmup S] [--timeout MS]\n"
+		<< "       [--flow kem|auth|both] [--binary] [--no-verify]" << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	LoadConfig config;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--host" && hasValue) {
+			config.host = argv[++i];
+		}
+		else if (arg == "--port" && hasValue) {
+			config.port = argv[++i];
+		}
+		else if (arg == "--devices" && hasValue) {
+			config.devices = strtoul(argv[++i], nullptr, 10);
+		}
+		else if (arg == "--threads" && hasValue) {
+			config.threads = strtoul(argv[++i], nullptr, 10);
+		}
+		else if (arg == "--duration" && hasValue) {
+			config.durationS = strtod(argv[++i], nullptr);
+		}
+		else if (arg == "--warmup" && hasValue) {
+			config.warmupS = strtod(argv[++i], nullptr);
+		}
+		else if (arg == "--timeout" && hasValue) {
+			config.timeoutMs = atoi(argv[++i]);
+		}
+		else if (arg == "--flow" && hasValue) {
+			string flow = argv[++i];
+			if (flow != "kem" && flow != "auth" && flow != "both") {
+				printUsage(argv[0]);
+				return 1;
+			}
+			config.kem = flow != "auth";
+			config.auth = flow != "kem";
+		}
+		else if (arg == "--binary") {
+			config.binary = true;
+		}
+		else if (arg == "--no-verify") {
+			config.verify = false;
+		}
+		else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (config.devices == 0 || config.threads == 0 || config.durationS <= 0 || config.timeoutMs <= 0) {
+		printUsage(argv[0]);
+		return 1;
+	}
+	config.threads = min(config.threads, config.devices);
+
+	// Step 1: Resolve the server address once
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* resolved = nullptr;
+	int rc = getaddrinfo(config.host.c_str(), config.port.c_str(), &hints, &resolved);
+	if (rc != 0) {
+		cerr << "Error: Cannot resolve " << config.host << ":" << config.port << ": " << gai_strerror(rc) << endl;
+		return 1;
+	}
+	sockaddr_storage addr{};
+	socklen_t addrLen = resolved->ai_addrlen;
+	memcpy(&addr, resolved->ai_addr, addrLen);
+	freeaddrinfo(resolved);
+
+	// Step 2: The firmware's verification key, prepared once for all devices
+	unique_ptr<PQCLEAN_MLDSA44_CLEAN_verifier, void (*)(PQCLEAN_MLDSA44_CLEAN_verifier*)> verifier(
+		nullptr, PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free);
+	if (config.auth && config.verify) {
+		uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES];
+		if (!loadKeyFromFile("PublicKeyDilithium.txt", pk, sizeof(pk))) {
+			cerr << "Error: Cannot load PublicKeyDilithium.txt (use --no-verify to skip verification)." << endl;
+			return 1;
+		}
+		verifier.reset(PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_new(pk));
+		if (!verifier) {
+			cerr << "Error: Out of memory." << endl;
+			return 1;
+		}
+	}
+	raiseFileLimit(config.devices);
+
+	// Step 3: Split the devices over the threads and run
+	Clock::time_point begin = Clock::now();
+	Clock::time_point measureStart = begin + chrono::duration_cast<Clock::duration>(chrono::duration<double>(config.warmupS));
+	Clock::time_point measureEnd = measureStart + chrono::duration_cast<Clock::duration>(chrono::duration<double>(config.durationS));
+	atomic<bool> stop{ false };
+	vector<unique_ptr<LoadThread>> loads;
+	vector<thread> threads;
+	for (size_t t = 0; t < config.threads; ++t) {
+		size_t share = config.devices / config.threads + (t < config.devices % config.threads ? 1 : 0);
+		loads.push_back(make_unique<LoadThread>(config, addr, addrLen, verifier.get(), share,
+			measureStart, measureEnd, stop));
+	}
+	for (auto& load : loads) {
+		threads.emplace_back([&load] { load->run(); });
+	}
+
+	const char* flowName = config.auth ? (config.kem ? "auth+kem" : "auth") : "kem";
+	cout << "Running " << config.devices << " devices on " << config.threads << " thread(s), flow "
+		<< flowName << (config.binary ? ", binary" : ", text") << ", against "
+		<< config.host << ":" << config.port << endl;
+
+	// Step 4: One progress line per second until the window closes
+	uint64_t lastCompleted = 0;
+	for (int second = 1; Clock::now() < measureEnd; ++second) {
+		this_thread::sleep_until(min(begin + chrono::seconds(second), measureEnd));
+		uint64_t completed = 0;
+		for (auto& load : loads) {
+			completed += load->statistics().completed.load(memory_order_relaxed);
+		}
+		cout << "[" << setw(4) << second << "s] " << setw(8) << completed - lastCompleted << " handshakes/s"
+			<< (Clock::now() < measureStart ? " (warmup)" : "") << endl;
+		lastCompleted = completed;
+	}
+	stop.store(true, memory_order_relaxed);
+	for (thread& t : threads) {
+		t.join();
+	}
+
+	// Step 5: Merge and report
+	vector<uint32_t> latencies;
+	uint64_t failures[FAILURE_KINDS] = {};
+	uint64_t failed = 0;
+	for (auto& load : loads) {
+		ThreadStats& stats = load->statistics();
+		latencies.insert(latencies.end(), stats.latencyUs.begin(), stats.latencyUs.end());
+		for (int kind = 0; kind < FAILURE_KINDS; ++kind) {
+			failures[kind] += stats.failures[kind];
+			failed += stats.failures[kind];
+		}
+	}
+	sort(latencies.begin(), latencies.end());
+
+	cout << fixed << setprecision(2);
+	cout << "Handshakes:   " << latencies.size() << " in " << config.durationS << " s ("
+		<< static_cast<double>(latencies.size()) / config.durationS << "/s)" << endl;
+	cout << "Failures:     " << failed << " (";
+	for (int kind = 0; kind < FAILURE_KINDS; ++kind) {
+		cout << (kind ? ", " : "") << FAILURE_NAMES[kind] << " " << failures[kind];
+	}
+	cout << ")" << endl;
+	cout << "Latency (ms): p50 " << percentile(latencies, 50) / 1000.0
+		<< "  p99 " << percentile(latencies, 99) / 1000.0
+		<< "  p999 " << percentile(latencies, 99.9) / 1000.0
+		<< "  max " << (latencies.empty() ? 0.0 : latencies.back() / 1000.0) << endl;
+	return latencies.empty() ? 1 : 0;
+}
@@ -0,0 +1,243 @@
+// PostQuantumSign.cpp
+/**
+ * @file PostQuantumSign.cpp
+ * @brief Command‑line tool that signs and verifies files (OTA images) with ML‑DSA‑44.
+ *
+ * Usage: PostQuantumSign sign|verify PATH [--threads N]
+ *
+ * PATH is a file or a directory (regular files directly inside it; existing
+ * .sig files are skipped). Each file is memory‑mapped and hashed in place,
+ * so no copy of the image is made. "sign" writes a detached signature of
+ * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES raw bytes to FILE.sig; "verify" checks
+ * FILE against FILE.sig. The keys are the server's SecretKeyDilithium.txt /
+ * PublicKeyDilithium.txt in the working directory.
+ */
+
+ // POSIX headers
+#include <sys/mman.h>   ///< for mmap(), madvise()
+#include <sys/stat.h>   ///< for fstat()
+#include <fcntl.h>      ///< for open()
+#include <unistd.h>     ///< for close()
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BulkDsaEngine.hpp"
+#include "Helpers.hpp"
+
+using namespace std;
+
+/**
+ * @brief Read‑only memory mapping of one input file.
+ */
+struct MappedFile {
+	string path;
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept
+		: path(std::move(other.path)), data(other.data), size(other.size) {
+		other.data = nullptr;
+		other.size = 0;
+	}
+	~MappedFile() {
+		if (data != nullptr) {
+			munmap(const_cast<uint8_t*>(data), size);
+		}
+	}
+
+	/**
+	 * @brief Map path read‑only. Empty files are valid and stay unmapped.
+	 * @return True on success; false if the file cannot be opened or mapped.
+	 */
+	bool open(const string& filePath) {
+		path = filePath;
+		int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return false;
+		}
+		struct stat st {};
+		if (fstat(fd, &st) != 0) {
+			close(fd);
+			return false;
+		}
+		size = static_cast<size_t>(st.st_size);
+		if (size > 0) {
+			void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p == MAP_FAILED) {
+				close(fd);
+				return false;
+			}
+			// SHAKE reads the image once, front to back
+			madvise(p, size, MADV_SEQUENTIAL);
+			data = static_cast<const uint8_t*>(p);
+		}
+		close(fd);
+		return true;
+	}
+};
+
+/**
+ * @brief Collect the input files: PATH itself, or the regular files in it.
+ */
+static bool listInputs(const string& path, vector<string>& files) {
+	error_code ec;
+	if (filesystem::is_regular_file(path, ec)) {
+		files.push_back(path);
+		return true;
+	}
+	if (!filesystem::is_directory(path, ec)) {
+		return false;
+	}
+	for (const auto& entry : filesystem::directory_iterator(path, ec)) {
+		if (entry.is_regular_file() && entry.path().extension() != ".sig") {
+			files.push_back(entry.path().string());
+		}
+	}
+	sort(files.begin(), files.end());
+	return !ec;
+}
+
+/**
+ * @brief Read a detached signature; returns its length or 0 on error.
+ */
+static size_t readSignature(const string& path, uint8_t* sig) {
+	ifstream ifs(path, ios::in | ios::binary);
+	if (!ifs.good()) {
+		return 0;
+	}
+	ifs.read(reinterpret_cast<char*>(sig), PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES);
+	return static_cast<size_t>(ifs.gcount());
+}
+
+/**
+ * @brief Write a detached signature next to the signed file.
+ */
+static bool writeSignature(const string& path, const uint8_t* sig, size_t sigLen) {
+	ofstream ofs(path, ios::out | ios::binary | ios::trunc);
+	if (!ofs.good()) {
+		return false;
+	}
+	ofs.write(reinterpret_cast<const char*>(sig), static_cast<streamsize>(sigLen));
+	return ofs.good();
+}
+
+/**
+ * @brief Entry point: parse arguments, map files, sign or verify in parallel.
+ * @return 0 if every file was signed / verified; 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+	if (argc != 3 && !(argc == 5 && strcmp(argv[3], "--threads") == 0)) {
+		cerr << "Usage: " << argv[0] << " sign|verify PATH [--threads N]" << endl;
+		return 1;
+	}
+	const bool signing = strcmp(argv[1], "sign") == 0;
+	if (!signing && strcmp(argv[1], "verify") != 0) {
+		cerr << "Error: Unknown command " << argv[1] << endl;
+		return 1;
+	}
+	size_t threads = argc == 5 ? static_cast<size_t>(strtoull(argv[4], nullptr, 10)) : 0;
+
+	// Keys shared with the server
+	uint8_t pk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES];
+	uint8_t sk[PQCLEAN_MLDSA44_CLEAN_CRYPTO_SECRETKEYBYTES];
+	PQCLEAN_MLDSA44_CLEAN_signer* signer = nullptr;
+	PQCLEAN_MLDSA44_CLEAN_verifier* verifier = nullptr;
+	if (signing) {
+		if (!loadKeyFromFile("SecretKeyDilithium.txt", sk, sizeof(sk))) {
+			cerr << "Error: Could not load SecretKeyDilithium.txt." << endl;
+			return 1;
+		}
+		signer = PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_new(sk);
+		secureZero(sk, sizeof(sk));
+	}
+	else {
+		if (!loadKeyFromFile("PublicKeyDilithium.txt", pk, sizeof(pk))) {
+			cerr << "Error: Could not load PublicKeyDilithium.txt." << endl;
+			return 1;
+		}
+		verifier = PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_new(pk);
+	}
+	if (signer == nullptr && verifier == nullptr) {
+		cerr << "Error: Could not prepare the key." << endl;
+		return 1;
+	}
+
+	vector<string> paths;
+	if (!listInputs(argv[2], paths) || paths.empty()) {
+		cerr << "Error: No input files at " << argv[2] << endl;
+		PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free(signer);
+		PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free(verifier);
+		return 1;
+	}
+
+	// Map every input and point one job at each mapping
+	vector<MappedFile> files;
+	files.reserve(paths.size());
+	vector<uint8_t> signatures(paths.size() * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES);
+	vector<DsaJob> jobs;
+	jobs.reserve(paths.size());
+	size_t failed = 0;
+	uint64_t totalBytes = 0;
+	for (const string& path : paths) {
+		MappedFile file;
+		if (!file.open(path)) {
+			cerr << "Error: Could not map " << path << endl;
+			++failed;
+			continue;
+		}
+		DsaJob job;
+		job.kind = signing ? DsaJob::Kind::Sign : DsaJob::Kind::Verify;
+		job.message = file.data;
+		job.messageLength = file.size;
+		job.signature = &signatures[jobs.size() * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES];
+		job.signer = signer;
+		job.verifier = verifier;
+		if (!signing) {
+			job.signatureLength = readSignature(path + ".sig", job.signature);
+		}
+		totalBytes += file.size;
+		files.push_back(std::move(file));
+		jobs.push_back(job);
+	}
+
+	BulkDsaEngine engine(threads);
+	auto start = chrono::steady_clock::now();
+	engine.submit(span<DsaJob>(jobs)).wait();
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	size_t succeeded = 0;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		const string& path = files[i].path;
+		if (signing && jobs[i].ok &&
+			!writeSignature(path + ".sig", jobs[i].signature, jobs[i].signatureLength)) {
+			cerr << "Error: Could not write " << path << ".sig" << endl;
+			jobs[i].ok = false;
+		}
+		if (jobs[i].ok) {
+			++succeeded;
+		}
+		else {
+			++failed;
+		}
+		cout << (jobs[i].ok ? "OK     " : "FAILED ") << path << endl;
+	}
+
+	double megabytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+	cout << (signing ? "Signed " : "Verified ") << succeeded << " of " << paths.size() << " files, "
+		<< megabytes << " MB in " << seconds * 1000.0 << " ms ("
+		<< (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s, " << engine.size() << " threads)." << endl;
+
+	PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free(signer);
+	PQCLEAN_MLDSA44_CLEAN_crypto_sign_verifier_free(verifier);
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,389 @@
+// PqBench.cpp
+/**
+ * @file PqBench.cpp
+ * @brief pq_bench entry point: harness, report and the symmetric / hex benchmarks.
+ *
+ * Usage: pq_bench [--filter SUBSTR] [--min-time MS] [--json FILE]
+ *
+ * Every benchmark is warmed up, then timed in samples of several calls each
+ * (so one sample lasts at least a few microseconds and the clock reads stay
+ * negligible) until --min-time has elapsed. The report lists rdtsc cycles/op
+ * and ns/op at the 50th, 90th and 99th percentile of the samples. --json
+ * writes the same numbers in a machine‑readable form for comparing runs.
+ * Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+ */
+
+#include "PqBench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Helpers.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>   ///< for __rdtsc()
+#define PQ_BENCH_HAVE_RDTSC 1
+#endif
+
+extern "C" {
+#include "aes.h"       ///< AES‑256‑CTR
+#include "fips202.h"   ///< SHAKE128/256, SHA3‑256/512
+}
+
+using namespace std;
+
+namespace {
+
+/// Target length of one timed sample
+constexpr double SAMPLE_NS = 5000.0;
+/// Warm‑up time per benchmark
+constexpr double WARMUP_NS = 20e6;
+/// Upper bound on stored samples per benchmark
+constexpr size_t MAX_SAMPLES = 200000;
+/// Minimum samples, even for operations slower than --min-time
+constexpr size_t MIN_SAMPLES = 10;
+
+/**
+ * @brief Time‑stamp counter, or 0 where there is none.
+ */
+inline uint64_t readCycles() {
+#ifdef PQ_BENCH_HAVE_RDTSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+inline double nowNs() {
+	return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Percentiles of one benchmark; all per‑operation values.
+ */
+struct BenchResult {
+	string name;
+	size_t bytes = 0;
+	uint64_t iterations = 0;
+	size_t samples = 0;
+	double nsMean = 0, nsP50 = 0, nsP90 = 0, nsP99 = 0, nsMin = 0;
+	double cyclesP50 = 0, cyclesP90 = 0, cyclesP99 = 0;
+};
+
+/**
+ * @brief Nearest‑rank percentile of sorted values.
+ */
+double percentile(const vector<double>& sorted, double p) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	size_t rank = static_cast<size_t>(ceil(p / 100.0 * static_cast<double>(sorted.size())));
+	return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+/**
+ * @brief Warm up, pick the batch size, then sample until minTimeNs has elapsed.
+ */
+BenchResult runCase(const BenchCase& bench, double minTimeNs) {
+	// Warm‑up doubles as a rough estimate of the cost of one call
+	uint64_t warmCalls = 0;
+	double start = nowNs();
+	double elapsed = 0;
+	while (elapsed < WARMUP_NS || warmCalls < 2) {
+		bench.op();
+		++warmCalls;
+		elapsed = nowNs() - start;
+	}
+	double estimate = elapsed / static_cast<double>(warmCalls);
+	uint64_t batch = estimate >= SAMPLE_NS ? 1 : static_cast<uint64_t>(ceil(SAMPLE_NS / max(estimate, 1.0)));
+
+	vector<double> ns;
+	vector<double> cycles;
+	ns.reserve(1024);
+	cycles.reserve(1024);
+	start = nowNs();
+	while ((nowNs() - start < minTimeNs || ns.size() < MIN_SAMPLES) && ns.size() < MAX_SAMPLES) {
+		uint64_t c0 = readCycles();
+		double t0 = nowNs();
+		for (uint64_t i = 0; i < batch; ++i) {
+			bench.op();
+		}
+		double t1 = nowNs();
+		uint64_t c1 = readCycles();
+		ns.push_back((t1 - t0) / static_cast<double>(batch));
+		cycles.push_back(static_cast<double>(c1 - c0) / static_cast<double>(batch));
+	}
+
+	BenchResult result;
+	result.name = bench.name;
+	result.bytes = bench.bytes;
+	result.samples = ns.size();
+	result.iterations = batch * ns.size();
+	double sum = 0;
+	for (double v : ns) {
+		sum += v;
+	}
+	result.nsMean = sum / static_cast<double>(ns.size());
+	sort(ns.begin(), ns.end());
+	sort(cycles.begin(), cycles.end());
+	result.nsMin = ns.front();
+	result.nsP50 = percentile(ns, 50);
+	result.nsP90 = percentile(ns, 90);
+	result.nsP99 = percentile(ns, 99);
+	result.cyclesP50 = percentile(cycles, 50);
+	result.cyclesP90 = percentile(cycles, 90);
+	result.cyclesP99 = percentile(cycles, 99);
+	return result;
+}
+
+/**
+ * @brief Throughput at the median, in MiB/s.
+ */
+double mibPerSecond(const BenchResult& r) {
+	return r.bytes == 0 || r.nsP50 <= 0 ? 0.0
+		: static_cast<double>(r.bytes) / (r.nsP50 * 1e-9) / (1024.0 * 1024.0);
+}
+
+void printHeader() {
+	cout << left << setw(40) << "benchmark" << right
+		<< setw(12) << "ns p50" << setw(12) << "ns p90" << setw(12) << "ns p99"
+		<< setw(14) << "cycles p50" << setw(14) << "cycles p99"
+		<< setw(12) << "MiB/s" << setw(12) << "iters" << endl;
+}
+
+void printResult(const BenchResult& r) {
+	cout << left << setw(40) << r.name << right << fixed << setprecision(1)
+		<< setw(12) << r.nsP50 << setw(12) << r.nsP90 << setw(12) << r.nsP99
+		<< setprecision(0)
+		<< setw(14) << r.cyclesP50 << setw(14) << r.cyclesP99
+		<< setprecision(1) << setw(12);
+	if (r.bytes != 0) {
+		cout << mibPerSecond(r);
+	}
+	else {
+		cout << "-";
+	}
+	cout << setw(12) << r.iterations << endl;
+	cout.unsetf(ios::floatfield);
+}
+
+/**
+ * @brief JSON string literal; benchmark names are plain ASCII, but stay safe.
+ */
+string jsonString(const string& s) {
+	string out = "\"";
+	for (char c : s) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20) {
+			char buf[8];
+			snprintf(buf, sizeof(buf), "\\u%04x", c);
+			out += buf;
+		}
+		else {
+			out += c;
+		}
+	}
+	return out + "\"";
+}
+
+/**
+ * @brief Write the run context and all results as one JSON document.
+ */
+bool writeJson(const string& path, const vector<BenchResult>& results, double minTimeMs) {
+	ofstream ofs(path, ios::out | ios::trunc);
+	if (!ofs.good()) {
+		return false;
+	}
+	char date[32];
+	time_t now = time(nullptr);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+	ofs << setprecision(6) << fixed;
+	ofs << "{\n  \"context\": {\n"
+		<< "    \"date\": " << jsonString(date) << ",\n"
+		<< "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n"
+#ifdef PQ_BENCH_HAVE_RDTSC
+		<< "    \"cycle_counter\": \"rdtsc\",\n"
+		<< "    \"avx2\": " << (__builtin_cpu_supports("avx2") ? "true" : "false") << ",\n"
+#else
+		<< "    \"cycle_counter\": null,\n"
+		<< "    \"avx2\": false,\n"
+#endif
+#ifdef __OPTIMIZE__
+		<< "    \"optimized\": true,\n"
+#else
+		<< "    \"optimized\": false,\n"
+#endif
+		<< "    \"min_time_ms\": " << minTimeMs << "\n"
+		<< "  },\n  \"benchmarks\": [";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const BenchResult& r = results[i];
+		ofs << (i == 0 ? "\n" : ",\n")
+			<< "    {\"name\": " << jsonString(r.name)
+			<< ", \"bytes_per_op\": " << r.bytes
+			<< ", \"iterations\": " << r.iterations
+			<< ", \"samples\": " << r.samples
+			<< ", \"ns_mean\": " << r.nsMean
+			<< ", \"ns_min\": " << r.nsMin
+			<< ", \"ns_p50\": " << r.nsP50
+			<< ", \"ns_p90\": " << r.nsP90
+			<< ", \"ns_p99\": " << r.nsP99
+			<< ", \"cycles_p50\": " << r.cyclesP50
+			<< ", \"cycles_p90\": " << r.cyclesP90
+			<< ", \"cycles_p99\": " << r.cyclesP99
+			<< ", \"mib_per_s\": " << mibPerSecond(r) << "}";
+	}
+	ofs << "\n  ]\n}\n";
+	return ofs.good();
+}
+
+/**
+ * @brief Fixed, non‑zero input bytes shared by the sized benchmarks.
+ */
+shared_ptr<vector<uint8_t>> patternBuffer(size_t size) {
+	auto buf = make_shared<vector<uint8_t>>(size);
+	for (size_t i = 0; i < size; ++i) {
+		(*buf)[i] = static_cast<uint8_t>(i * 131 + 7);
+	}
+	return buf;
+}
+
+/**
+ * @brief SHAKE / SHA3 over several input sizes, AES‑256‑CTR keystream and the hex codecs.
+ */
+void registerSymmetricBenchmarks(BenchRegistry& registry) {
+	static const size_t HASH_SIZES[] = { 32, 1024, 16384 };
+	for (size_t size : HASH_SIZES) {
+		auto in = patternBuffer(size);
+		string suffix = "/";
+		suffix += to_string(size);
+		// 32‑byte output: the seed / digest size the schemes squeeze most often
+		registry.add("shake128" + suffix, size, [in] {
+			uint8_t out[32];
+			shake128(out, sizeof(out), in->data(), in->size());
+		});
+		registry.add("shake256" + suffix, size, [in] {
+			uint8_t out[32];
+			shake256(out, sizeof(out), in->data(), in->size());
+		});
+		registry.add("sha3_256" + suffix, size, [in] {
+			uint8_t out[32];
+			sha3_256(out, in->data(), in->size());
+		});
+		registry.add("sha3_512" + suffix, size, [in] {
+			uint8_t out[64];
+			sha3_512(out, in->data(), in->size());
+		});
+	}
+
+	// AES‑256‑CTR as used for ConfidentialData: expand once, then keystream
+	struct AesState {
+		aes256ctx ctx{};
+		uint8_t iv[AESCTR_NONCEBYTES] = {};
+		~AesState() { aes256_ctx_release(&ctx); }
+	};
+	auto aes = make_shared<AesState>();
+	auto key = patternBuffer(32);
+	aes256_ctr_keyexp(&aes->ctx, key->data());
+	registry.add("aes256ctr/keyexp", 0, [key] {
+		aes256ctx ctx;
+		aes256_ctr_keyexp(&ctx, key->data());
+		aes256_ctx_release(&ctx);
+	});
+	static const size_t AES_SIZES[] = { 64, 1024, 16384 };
+	for (size_t size : AES_SIZES) {
+		auto out = make_shared<vector<uint8_t>>(size);
+		registry.add("aes256ctr/" + to_string(size), size, [aes, out] {
+			aes256_ctr(out->data(), out->size(), aes->iv, &aes->ctx);
+		});
+	}
+
+	// Hex codecs: a shared secret, a KEM public key (800 B), a DSA signature, a large buffer
+	static const size_t HEX_SIZES[] = { 32, 800, 2420, 16384 };
+	for (size_t size : HEX_SIZES) {
+		auto bytes = patternBuffer(size);
+		auto text = make_shared<vector<char>>(size * 2);
+		bytesToHex(span<const uint8_t>(*bytes), span<char>(*text));
+		string suffix = "/";
+		suffix += to_string(size);
+		registry.add("hex/encode" + suffix, size, [bytes, text] {
+			bytesToHex(span<const uint8_t>(*bytes), span<char>(*text));
+		});
+		registry.add("hex/decode" + suffix, size, [bytes, text] {
+			hexToBytes(string_view(text->data(), text->size()), span<uint8_t>(*bytes));
+		});
+	}
+}
+
+} // namespace
+
+/**
+ * @brief Entry point: parse options, register, run and report.
+ * @return 0 on success; 1 on bad arguments, an empty selection or a JSON write error.
+ */
+int main(int argc, char* argv[]) {
+	string filter;
+	string jsonPath;
+	double minTimeMs = 300.0;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--filter" && i + 1 < argc) {
+			filter = argv[++i];
+		}
+		else if (arg == "--json" && i + 1 < argc) {
+			jsonPath = argv[++i];
+		}
+		else if (arg == "--min-time" && i + 1 < argc) {
+			minTimeMs = strtod(argv[++i], nullptr);
+		}
+		else {
+			cerr << "Usage: " << argv[0] << " [--filter SUBSTR] [--min-time MS] [--json FILE]" << endl;
+			return 1;
+		}
+	}
+
+	BenchRegistry registry;
+	registerKemBenchmarks(registry);
+	registerDsaBenchmarks(registry);
+	registerSymmetricBenchmarks(registry);
+
+#ifndef __OPTIMIZE__
+	cerr << "Warning: pq_bench was built without optimization; configure with -DCMAKE_BUILD_TYPE=Release." << endl;
+#endif
+
+	vector<BenchResult> results;
+	printHeader();
+	for (const BenchCase& bench : registry.all()) {
+		if (!filter.empty() && bench.name.find(filter) == string::npos) {
+			continue;
+		}
+		results.push_back(runCase(bench, minTimeMs * 1e6));
+		printResult(results.back());
+	}
+	if (results.empty()) {
+		cerr << "Error: No benchmark matches " << filter << endl;
+		return 1;
+	}
+
+	if (!jsonPath.empty() && !writeJson(jsonPath, results, minTimeMs)) {
+		cerr << "Error: Could not write " << jsonPath << endl;
+		return 1;
+	}
+	return 0;
+}
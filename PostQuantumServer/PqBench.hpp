@@ -0,0 +1,57 @@
+// PqBench.hpp
+/**
+ * @file PqBench.hpp
+ * @brief Micro‑benchmark harness for the PQClean primitives used by the server.
+ *
+ * Each benchmark is a named closure that performs one operation. The harness
+ * runs it in timed samples and reports rdtsc cycles/op and ns/op percentiles.
+ * The ML‑KEM and ML‑DSA internals cannot share a translation unit (both
+ * define poly, params and the Montgomery constants), so each scheme registers
+ * its benchmarks from its own file.
+ */
+
+#ifndef PQ_BENCH_HPP
+#define PQ_BENCH_HPP
+
+#include <cstddef>      ///< for size_t
+#include <functional>   ///< for std::function
+#include <string>       ///< for std::string
+#include <vector>       ///< for benchmark list
+
+/**
+ * @brief One registered benchmark.
+ */
+struct BenchCase {
+	std::string name;            ///< "group/operation[/size]"
+	size_t bytes = 0;            ///< Payload bytes per operation; 0 if not a throughput benchmark
+	std::function<void()> op;    ///< Runs the operation exactly once
+};
+
+/**
+ * @brief Ordered list of benchmarks; the order is the report order.
+ */
+class BenchRegistry {
+public:
+	/**
+	 * @brief Register a benchmark.
+	 * @param name  Unique name, matched by --filter.
+	 * @param bytes Payload bytes per call, used for the MB/s column.
+	 * @param op    Operation to time; state it needs is captured by the closure.
+	 */
+	void add(std::string name, size_t bytes, std::function<void()> op) {
+		cases.push_back(BenchCase{ std::move(name), bytes, std::move(op) });
+	}
+
+	const std::vector<BenchCase>& all() const { return cases; }
+
+private:
+	std::vector<BenchCase> cases;
+};
+
+/** @brief ML‑KEM‑512 API, NTT, basemul and gen_matrix (PqBenchKem.cpp). */
+void registerKemBenchmarks(BenchRegistry& registry);
+
+/** @brief ML‑DSA‑44 API, NTT, pointwise and poly_uniform (PqBenchDsa.cpp). */
+void registerDsaBenchmarks(BenchRegistry& registry);
+
+#endif // PQ_BENCH_HPP
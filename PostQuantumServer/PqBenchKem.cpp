@@ -0,0 +1,86 @@
+// PqBenchKem.cpp
+/**
+ * @file PqBenchKem.cpp
+ * @brief ML‑KEM‑512 benchmarks: the KEM API and its NTT / sampling kernels.
+ */
+
+#include "PqBench.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// PQClean internals last: params.h defines short macros such as KYBER_K
+extern "C" {
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/api.h"      ///< KEM API, prepared keys
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/indcpa.h"   ///< gen_matrix
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/poly.h"     ///< poly_ntt, poly_basemul_montgomery
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/polyvec.h"  ///< polyvec
+}
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Keys, ciphertexts and polynomials shared by the KEM benchmarks.
+ */
+struct KemState {
+	uint8_t pk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES];
+	uint8_t sk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES];
+	uint8_t ct[PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES];
+	uint8_t ss[PQCLEAN_MLKEM512_CLEAN_CRYPTO_BYTES];
+	uint8_t seed[KYBER_SYMBYTES];
+	polyvec matrix[KYBER_K];
+	poly a, b, r;
+	PQCLEAN_MLKEM512_CLEAN_kemkey* key = nullptr;
+
+	~KemState() { PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_free(key); }
+};
+
+} // namespace
+
+void registerKemBenchmarks(BenchRegistry& registry) {
+	auto s = make_shared<KemState>();
+	PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(s->pk, s->sk);
+	PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(s->ct, s->ss, s->pk);
+	s->key = PQCLEAN_MLKEM512_CLEAN_crypto_kem_key_new(s->sk);
+	for (size_t i = 0; i < sizeof(s->seed); ++i) {
+		s->seed[i] = static_cast<uint8_t>(i);
+	}
+	// Coefficients in [0, q) so repeated transforms stay in range
+	for (int i = 0; i < KYBER_N; ++i) {
+		s->a.coeffs[i] = static_cast<int16_t>((i * 1663) % KYBER_Q);
+		s->b.coeffs[i] = static_cast<int16_t>((i * 2731 + 17) % KYBER_Q);
+	}
+	s->r = s->a;
+
+	registry.add("mlkem512/keypair", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(s->pk, s->sk);
+	});
+	registry.add("mlkem512/enc", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(s->ct, s->ss, s->pk);
+	});
+	registry.add("mlkem512/dec", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(s->ss, s->ct, s->sk);
+	});
+	registry.add("mlkem512/enc_key", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc_key(s->ct, s->ss, s->key);
+	});
+	registry.add("mlkem512/dec_key", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec_key(s->ss, s->ct, s->key);
+	});
+	registry.add("mlkem512/gen_matrix", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_gen_matrix(s->matrix, s->seed, 0);
+	});
+	registry.add("mlkem512/poly_ntt", 0, [s] {
+		// poly_ntt ends with a Barrett reduction, so r stays bounded
+		PQCLEAN_MLKEM512_CLEAN_poly_ntt(&s->r);
+	});
+	registry.add("mlkem512/poly_invntt_tomont", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_poly_invntt_tomont(&s->r);
+	});
+	registry.add("mlkem512/poly_basemul_montgomery", 0, [s] {
+		PQCLEAN_MLKEM512_CLEAN_poly_basemul_montgomery(&s->r, &s->a, &s->b);
+	});
+}
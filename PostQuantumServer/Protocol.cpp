@@ -0,0 +1,63 @@
+// Protocol.cpp
+/**
+ * @file Protocol.cpp
+ * @brief Implementation of binary frame encoding and decoding.
+ */
+
+#include "Protocol.hpp"
+
+/** A 32‑bit LEB128 value never needs more than 5 bytes. */
+const size_t MAX_VARINT_BYTES = 5;
+
+FrameStatus decodeFrame(const uint8_t* data, size_t size, Frame& frame, size_t& consumed) {
+	if (size < 2) {
+		return FrameStatus::Incomplete;
+	}
+	// Step 1: Decode the LEB128 payload length after the type byte
+	uint64_t length = 0;
+	size_t pos = 1;
+	for (size_t shift = 0;; shift += 7) {
+		if (pos > MAX_VARINT_BYTES) {
+			return FrameStatus::Invalid;
+		}
+		if (pos >= size) {
+			return FrameStatus::Incomplete;
+		}
+		uint8_t byte = data[pos++];
+		length |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			break;
+		}
+	}
+	if (length > PROTO_MAX_PAYLOAD) {
+		return FrameStatus::Invalid;
+	}
+	// Step 2: Wait for the whole payload
+	if (size - pos < length) {
+		return FrameStatus::Incomplete;
+	}
+	frame.type = static_cast<FrameType>(data[0]);
+	frame.payload = data + pos;
+	frame.length = static_cast<size_t>(length);
+	consumed = pos + frame.length;
+	return FrameStatus::Complete;
+}
+
+void appendFrameHeader(std::string& out, FrameType type, size_t length) {
+	out.push_back(static_cast<char>(type));
+	do {
+		uint8_t byte = length & 0x7F;
+		length >>= 7;
+		if (length != 0) {
+			byte |= 0x80;
+		}
+		out.push_back(static_cast<char>(byte));
+	} while (length != 0);
+}
+
+void appendFrame(std::string& out, FrameType type, const uint8_t* payload, size_t length) {
+	appendFrameHeader(out, type, length);
+	if (length > 0) {
+		out.append(reinterpret_cast<const char*>(payload), length);
+	}
+}
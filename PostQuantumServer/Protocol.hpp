@@ -0,0 +1,89 @@
+// Protocol.hpp
+/**
+ * @file Protocol.hpp
+ * @brief Length‑prefixed binary framing used alongside the hex text protocol.
+ *
+ * A connection starts in text mode. A client that wants binary framing sends
+ * a single version byte (0xB0 | version) before anything else; the server
+ * answers with the version byte it will speak (never newer than requested)
+ * and both sides switch to frames of the form
+ *
+ *     [type : 1 byte][length : LEB128 varint][payload : length bytes]
+ *
+ * Payloads carry raw bytes instead of uppercase hex, so keys, ciphertexts
+ * and signatures take half the bytes on the wire and need no hex parsing.
+ */
+
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <cstddef>   ///< for size_t
+#include <cstdint>   ///< for uint8_t, uint32_t
+#include <string>    ///< for std::string
+
+/** Upper nibble of the version byte that opens a binary connection. */
+const uint8_t PROTO_BINARY_MAGIC = 0xB0;
+/** Highest binary protocol version this server speaks. */
+const uint8_t PROTO_BINARY_VERSION = 1;
+/** Largest payload accepted in a single frame. */
+const uint32_t PROTO_MAX_PAYLOAD = 64 * 1024;
+
+/**
+ * @brief Binary frame types; each mirrors one text verb.
+ */
+enum class FrameType : uint8_t {
+	KemRequest = 0x01,       ///< empty                 (text: "KemRequest")
+	KemInit = 0x02,          ///< KEM public key        (text: "KemInit:<hex>")
+	KemCipher = 0x03,        ///< KEM ciphertext        (text: "KemCipher:<hex>")
+	ConfidentialData = 0x04, ///< IV || AES‑CTR data    (text: "ConfidentialData:<iv>:<ct>")
+	AuthRequest = 0x05,      ///< empty                 (text: "AuthRequest")
+	AuthReply = 0x06,        ///< message || signature  (text: "<message>|signature:<hex>")
+	Ack = 0x07               ///< empty                 (text: "Ack")
+};
+
+/**
+ * @brief A decoded frame pointing into the caller's receive buffer.
+ */
+struct Frame {
+	FrameType type;          ///< Frame type byte
+	const uint8_t* payload;  ///< First payload byte (not owned)
+	size_t length;           ///< Payload length in bytes
+};
+
+/**
+ * @brief Outcome of trying to decode one frame.
+ */
+enum class FrameStatus {
+	Complete,   ///< A whole frame was decoded
+	Incomplete, ///< More bytes are needed
+	Invalid     ///< Malformed length or payload over PROTO_MAX_PAYLOAD
+};
+
+/**
+ * @brief Decode one frame from the start of a buffer.
+ * @param data     Received bytes.
+ * @param size     Number of bytes available.
+ * @param frame    Receives the frame when Complete.
+ * @param consumed Receives the total frame size (header + payload) when Complete.
+ * @return Whether a frame was decoded, more data is needed, or the input is invalid.
+ */
+FrameStatus decodeFrame(const uint8_t* data, size_t size, Frame& frame, size_t& consumed);
+
+/**
+ * @brief Append a frame header (type and varint length) to out.
+ * @param out    Output buffer.
+ * @param type   Frame type.
+ * @param length Payload length that will follow.
+ */
+void appendFrameHeader(std::string& out, FrameType type, size_t length);
+
+/**
+ * @brief Append a complete frame to out.
+ * @param out     Output buffer.
+ * @param type    Frame type.
+ * @param payload Payload bytes (may be null when length is 0).
+ * @param length  Payload length.
+ */
+void appendFrame(std::string& out, FrameType type, const uint8_t* payload, size_t length);
+
+#endif // PROTOCOL_HPP
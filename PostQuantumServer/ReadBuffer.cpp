@@ -0,0 +1,55 @@
+// ReadBuffer.cpp
+/**
+ * @file ReadBuffer.cpp
+ * @brief Implementation of the growable receive buffer.
+ */
+
+#include "ReadBuffer.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+char* ReadBuffer::prepare(size_t minSpace) {
+	if (space() >= minSpace) {
+		return storage.get() + end;
+	}
+	// Step 1: Move a partial frame to the front to reuse consumed room
+	size_t pending = size();
+	if (start > 0 && capacity - pending >= minSpace) {
+		memmove(storage.get(), storage.get() + start, pending);
+		start = 0;
+		end = pending;
+		return storage.get() + end;
+	}
+	// Step 2: Grow geometrically, keeping the pending bytes
+	size_t newCapacity = capacity > 0 ? capacity * 2 : minSpace;
+	while (newCapacity - pending < minSpace) {
+		newCapacity *= 2;
+	}
+	unique_ptr<char[]> grown(new char[newCapacity]);
+	if (pending > 0) {
+		memcpy(grown.get(), storage.get() + start, pending);
+	}
+	storage = move(grown);
+	capacity = newCapacity;
+	start = 0;
+	end = pending;
+	return storage.get() + end;
+}
+
+void ReadBuffer::consume(size_t n) {
+	start += n;
+	if (start == end) {
+		// Fully parsed: next read starts at the front again
+		start = end = 0;
+	}
+}
+
+void ReadBuffer::shrink(size_t keep) {
+	clear();
+	if (capacity > keep) {
+		storage.reset();
+		capacity = 0;
+	}
+}
@@ -0,0 +1,55 @@
+// ReadBuffer.hpp
+/**
+ * @file ReadBuffer.hpp
+ * @brief Growable per‑connection receive buffer for stream reassembly.
+ */
+
+#ifndef READ_BUFFER_HPP
+#define READ_BUFFER_HPP
+
+#include <cstddef>   ///< for size_t
+#include <memory>    ///< for std::unique_ptr
+
+/**
+ * @brief Contiguous byte window [start, end) over a reusable allocation.
+ *
+ * recv() appends at the end, the parser consumes complete messages from
+ * the front. Unconsumed bytes (a partial frame) stay in place across reads
+ * and are moved to the front only when room is needed at the back. The
+ * allocation grows geometrically and is kept between messages, so steady
+ * traffic never touches the heap.
+ */
+class ReadBuffer {
+public:
+	/**
+	 * @brief Make room for at least minSpace bytes after the buffered data.
+	 * @return Where the next recv() should write; space() bytes are free.
+	 */
+	char* prepare(size_t minSpace);
+
+	/** @brief Mark n bytes written at prepare() as received. */
+	void commit(size_t n) { end += n; }
+
+	/** @brief Drop n bytes from the front once they were parsed. */
+	void consume(size_t n);
+
+	/** @brief Forget all buffered bytes but keep the allocation. */
+	void clear() { start = end = 0; }
+
+	/**
+	 * @brief Forget all buffered bytes and free the allocation if it grew past keep.
+	 */
+	void shrink(size_t keep);
+
+	char* data() { return storage.get() + start; }
+	size_t size() const { return end - start; }
+	size_t space() const { return capacity - end; }
+
+private:
+	std::unique_ptr<char[]> storage;
+	size_t capacity = 0;
+	size_t start = 0;
+	size_t end = 0;
+};
+
+#endif // READ_BUFFER_HPP
@@ -0,0 +1,935 @@
+﻿// Server.cpp
+/**
+ * @file Server.cpp
+ * @brief Implementation of the epoll‑based post‑quantum cryptography server.
+ */
+
+#include "Server.hpp"
+
+ // POSIX socket / epoll headers
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <cstring>
+#include <vector>
+#include <ctime>      ///< for time()
+#include "Helpers.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Protocol.hpp"
+
+extern "C" {
+#include "PQClean-master/crypto_sign/ml-dsa-44/clean/api.h"   ///< ML-DSA signatures
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/api.h"   ///< ML-KEM key encapsulation
+#include "aes.h"                                             ///< AES‑256‑CTR
+#include "ctxalloc.h"                                         ///< PQClean context allocator
+#include "pqbench.h"                                          ///< DBENCH stage profiler
+}
+
+using namespace std;
+
+/** recv() always gets at least this much room; the buffer grows as needed. */
+const size_t READ_CHUNK = 4096;
+/** Longest text line accepted: a hex ConfidentialData carrying PROTO_MAX_PAYLOAD bytes. */
+const size_t MAX_LINE = 2 * PROTO_MAX_PAYLOAD + 64;
+const int MAX_EVENTS = 256;
+const size_t INITIAL_SESSIONS = 1024;
+
+// epoll tokens for the server's own descriptors; session ids are >= 2^32
+const uint64_t LISTEN_ID = 0;
+const uint64_t SIGNAL_ID = 1;
+const uint64_t WAKE_ID = 2;
+
+/**
+ * @brief Print where sign/verify/encaps/decaps spent their cycles so far.
+ *
+ * Only PQCLEAN_BENCH builds collect the numbers; otherwise this is a no‑op.
+ */
+static void printStageProfile() {
+	if (!pqclean_bench_enabled()) {
+		return;
+	}
+	pqclean_bench_report report;
+	pqclean_bench_snapshot(&report);
+	logWrite(LogLevel::Info, NO_SESSION, "PQClean stage profile (cycles/op, share of op):");
+	// The table goes straight to stdout: let the queued records go first
+	logFlush();
+	pqclean_bench_print(stdout, &report);
+	fflush(stdout);
+}
+
+Server::Server(const uint8_t* signSk, const ServerConfig& config)
+	: signSk(signSk), config(config), sessions(INITIAL_SESSIONS) {
+}
+
+Server::~Server() {
+	// Join workers first so no job can post into a half‑destroyed server
+	pool.reset();
+	sessions.forEach([](Session& session) {
+		close(session.conn.fd);
+		session.reset();
+	});
+	if (ctxPoolInstalled) {
+		pqclean_set_allocator(nullptr);
+		pqclean_slab_release();
+	}
+	if (wakeFd >= 0) close(wakeFd);
+	if (signalFd >= 0) close(signalFd);
+	if (epollFd >= 0) close(epollFd);
+	if (listenFd >= 0) close(listenFd);
+}
+
+bool Server::start() {
+	// Step 1: Create non‑blocking listening socket
+	listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (listenFd < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Socket creation failed. Code: %d", errno);
+		return false;
+	}
+	int reuse = 1;
+	setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	// Step 2: Bind to the port on any interface
+	sockaddr_in serverAddr{};
+	serverAddr.sin_family = AF_INET;
+	serverAddr.sin_addr.s_addr = INADDR_ANY;
+	serverAddr.sin_port = htons(config.port);
+	if (bind(listenFd, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Bind failed. Code: %d", errno);
+		return false;
+	}
+
+	// Step 3: Listen for incoming connections
+	if (listen(listenFd, SOMAXCONN) < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "Listen failed. Code: %d", errno);
+		return false;
+	}
+
+	// Step 4: Create epoll instance and register the listener
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFd < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "epoll_create1 failed. Code: %d", errno);
+		return false;
+	}
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.u64 = LISTEN_ID;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev) < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "epoll_ctl(listen) failed. Code: %d", errno);
+		return false;
+	}
+
+	// Step 5: Route SIGINT/SIGTERM through the loop for a clean shutdown,
+	// SIGUSR1 for a stage profile dump while running
+	sigset_t mask;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGINT);
+	sigaddset(&mask, SIGTERM);
+	sigaddset(&mask, SIGUSR1);
+	sigprocmask(SIG_BLOCK, &mask, nullptr);
+	signal(SIGPIPE, SIG_IGN);
+	signalFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+	if (signalFd >= 0) {
+		ev.events = EPOLLIN;
+		ev.data.u64 = SIGNAL_ID;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, signalFd, &ev);
+	}
+
+	// Step 6: Wake‑up channel for finished crypto jobs
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wakeFd < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "eventfd failed. Code: %d", errno);
+		return false;
+	}
+	ev.events = EPOLLIN;
+	ev.data.u64 = WAKE_ID;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev) < 0) {
+		logWrite(LogLevel::Error, NO_SESSION, "epoll_ctl(eventfd) failed. Code: %d", errno);
+		return false;
+	}
+
+	// Step 7: Serve PQClean key schedules and hash states from the slab pool
+	if (config.ctxPool) {
+		pqclean_set_allocator(pqclean_slab_allocator());
+		ctxPoolInstalled = true;
+	}
+
+	// Step 8: Start the crypto worker pool
+	size_t threads = config.workerThreads;
+	if (threads == 0) {
+		threads = thread::hardware_concurrency();
+	}
+	pool = make_unique<WorkerPool>(threads, config.jobQueueCapacity);
+
+	// Step 9: Unpack and expand the signing key once for all AuthReplies
+	signer.reset(PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_new(signSk));
+	if (!signer) {
+		logWrite(LogLevel::Error, NO_SESSION, "Could not prepare the signing key.");
+		return false;
+	}
+
+	if (config.authCache) {
+		authCache = make_unique<AuthReplyCache>();
+	}
+
+	// Step 10: Start pre‑generating ephemeral KEM keypairs
+	if (config.kemPoolHigh > 0) {
+		keypairs = make_unique<KeypairPool>(config.kemPoolLow, config.kemPoolHigh);
+	}
+
+	// Step 11: Serve metrics on their own port and thread
+	if (config.metricsPort > 0) {
+		metrics = make_unique<MetricsServer>(config.metricsPort);
+		if (!metrics->start()) {
+			return false;
+		}
+	}
+
+	logWrite(LogLevel::Info, NO_SESSION, "Server listening on port %u with %zu crypto worker(s)...",
+		static_cast<unsigned>(config.port), pool->size());
+	return true;
+}
+
+int Server::run() {
+	epoll_event events[MAX_EVENTS];
+	while (true) {
+		int n = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			logWrite(LogLevel::Error, NO_SESSION, "epoll_wait failed. Code: %d", errno);
+			return 1;
+		}
+		for (int i = 0; i < n; ++i) {
+			uint64_t id = events[i].data.u64;
+			if (id == LISTEN_ID) {
+				acceptClients();
+				continue;
+			}
+			if (id == SIGNAL_ID) {
+				signalfd_siginfo info{};
+				if (read(signalFd, &info, sizeof(info)) == sizeof(info) && info.ssi_signo == SIGUSR1) {
+					printStageProfile();
+					continue;
+				}
+				logWrite(LogLevel::Info, NO_SESSION, "Shutdown requested.");
+				if (keypairs) {
+					logWrite(LogLevel::Info, NO_SESSION, "KEM keypair pool: %llu hits, %llu misses.",
+						static_cast<unsigned long long>(keypairs->hits()),
+						static_cast<unsigned long long>(keypairs->misses()));
+				}
+				if (authCache) {
+					uint64_t total = authCache->hits() + authCache->misses();
+					logWrite(LogLevel::Info, NO_SESSION, "AuthReply cache: %llu hits, %llu misses (%llu%% hit rate).",
+						static_cast<unsigned long long>(authCache->hits()),
+						static_cast<unsigned long long>(authCache->misses()),
+						static_cast<unsigned long long>(total ? authCache->hits() * 100 / total : 0));
+				}
+				if (ctxPoolInstalled) {
+					size_t blocks = 0;
+					size_t freeBlocks = 0;
+					pqclean_slab_usage(&blocks, &freeBlocks);
+					logWrite(LogLevel::Info, NO_SESSION,
+						"PQClean contexts: %llu allocations in %llu crypto jobs (slab pool: %zu blocks, %zu free).",
+						static_cast<unsigned long long>(pool->ctxAllocations()),
+						static_cast<unsigned long long>(pool->jobsRun()), blocks, freeBlocks);
+				}
+				else {
+					logWrite(LogLevel::Info, NO_SESSION, "PQClean contexts: %llu allocations in %llu crypto jobs.",
+						static_cast<unsigned long long>(pool->ctxAllocations()),
+						static_cast<unsigned long long>(pool->jobsRun()));
+				}
+				printStageProfile();
+				return 0;
+			}
+			if (id == WAKE_ID) {
+				runCompletions();
+				continue;
+			}
+			Session* session = sessions.find(id);
+			if (!session) {
+				continue;
+			}
+			if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+				logWrite(LogLevel::Debug, id, "Client disconnected.");
+				closeConnection(id);
+				continue;
+			}
+			if (events[i].events & EPOLLOUT) {
+				handleWritable(*session);
+				if (!sessions.find(id)) continue;
+			}
+			if (events[i].events & EPOLLIN) {
+				handleReadable(*session);
+			}
+		}
+		// Sign every AuthRequest parsed in this round in as few jobs as possible
+		if (!pendingAuth.empty()) {
+			flushAuthBatches();
+		}
+	}
+}
+
+void Server::acceptClients() {
+	// Drain the accept queue; the listener is non‑blocking
+	while (true) {
+		sockaddr_in clientAddr;
+		socklen_t clientLen = sizeof(clientAddr);
+		int fd = accept4(listenFd, reinterpret_cast<sockaddr*>(&clientAddr), &clientLen,
+			SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+				logWrite(LogLevel::Error, NO_SESSION, "Accept failed. Code: %d", errno);
+			}
+			return;
+		}
+		Session& session = sessions.acquire();
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.u64 = session.conn.id;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+			logWrite(LogLevel::Error, NO_SESSION, "epoll_ctl(client) failed. Code: %d", errno);
+			close(fd);
+			sessions.release(session);
+			continue;
+		}
+		session.conn.fd = fd;
+		session.conn.events = ev.events;
+		session.conn.acceptedNs = metricsNow();
+		countEvent(Counter::ConnectionsAccepted);
+		logWrite(LogLevel::Debug, session.conn.id, "Client connected.");
+	}
+}
+
+void Server::handleReadable(Session& session) {
+	Connection& conn = session.conn;
+	uint64_t id = conn.id;
+	// Step 1: Append to whatever partial message is already buffered
+	char* dst = conn.inBuf.prepare(READ_CHUNK);
+	ssize_t bytesRead = recv(conn.fd, dst, conn.inBuf.space(), 0);
+	if (bytesRead < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+			return;
+		}
+		logWrite(LogLevel::Error, id, "recv() failed. Code: %d", errno);
+		closeConnection(id);
+		return;
+	}
+	if (bytesRead == 0) {
+		logWrite(LogLevel::Debug, id, "Client disconnected.");
+		closeConnection(id);
+		return;
+	}
+	countEvent(Counter::BytesReceived, static_cast<uint64_t>(bytesRead));
+	if (conn.state == ConnState::Closing) {
+		// Ignore further input while the final reply drains
+		conn.inBuf.clear();
+		return;
+	}
+	conn.inBuf.commit(static_cast<size_t>(bytesRead));
+
+	// Step 2: Handle every complete message, keep a partial one for the next read
+	processInput(session);
+}
+
+void Server::processInput(Session& session) {
+	uint64_t id = session.conn.id;
+	Session* live = &session;
+	// Stop once a handler closed the session or paused it for a crypto job;
+	// the rest stays buffered until the job completes
+	while (live && !live->conn.busy && live->conn.state != ConnState::Closing) {
+		Connection& conn = live->conn;
+		if (conn.inBuf.size() == 0) {
+			return;
+		}
+		// A leading version byte selects binary framing for this connection
+		if (conn.mode == WireMode::Undecided) {
+			uint8_t first = static_cast<uint8_t>(conn.inBuf.data()[0]);
+			if ((first & 0xF0) == PROTO_BINARY_MAGIC && (first & 0x0F) != 0) {
+				uint8_t version = min<uint8_t>(first & 0x0F, PROTO_BINARY_VERSION);
+				conn.mode = WireMode::Binary;
+				conn.inBuf.consume(1);
+				char reply = static_cast<char>(PROTO_BINARY_MAGIC | version);
+				if (!queueSend(conn, string_view(&reply, 1))) {
+					closeConnection(id);
+					return;
+				}
+			}
+			else {
+				conn.mode = WireMode::Text;
+			}
+			continue;
+		}
+		bool handled = conn.mode == WireMode::Binary ? nextFrame(*live) : nextLine(*live);
+		if (!handled) {
+			return;
+		}
+		live = sessions.find(id);
+	}
+}
+
+bool Server::nextLine(Session& session) {
+	Connection& conn = session.conn;
+	char* line = conn.inBuf.data();
+	size_t size = conn.inBuf.size();
+	char* newline = static_cast<char*>(memchr(line, '\n', size));
+	if (!newline) {
+		if (size > MAX_LINE) {
+			logWrite(LogLevel::Error, conn.id, "Line too long.");
+			closeConnection(conn.id);
+		}
+		return false;
+	}
+	// The line stays valid in place until the next recv()
+	size_t lineLen = static_cast<size_t>(newline - line);
+	conn.inBuf.consume(lineLen + 1);
+
+	// Null‑terminate and trim CR
+	*newline = '\0';
+	while (lineLen > 0 && line[lineLen - 1] == '\r') {
+		line[--lineLen] = '\0';
+	}
+	// skip totally empty
+	if (lineLen > 0) {
+		handleMessage(session, line);
+	}
+	return true;
+}
+
+bool Server::nextFrame(Session& session) {
+	Connection& conn = session.conn;
+	Frame frame;
+	size_t consumed = 0;
+	FrameStatus status = decodeFrame(reinterpret_cast<const uint8_t*>(conn.inBuf.data()),
+		conn.inBuf.size(), frame, consumed);
+	if (status == FrameStatus::Incomplete) {
+		return false;
+	}
+	if (status == FrameStatus::Invalid) {
+		logWrite(LogLevel::Error, conn.id, "Malformed binary frame.");
+		closeConnection(conn.id);
+		return false;
+	}
+	// The payload stays valid in place until the next recv()
+	conn.inBuf.consume(consumed);
+	handleFrame(session, frame);
+	return true;
+}
+
+void Server::handleMessage(Session& session, char* msg) {
+	const char* prefixKemRequest = "KemRequest";
+	const char* prefixCipher = "KemCipher:";
+	const char* prefixAES = "ConfidentialData:";
+	const char* prefixAuthRequest = "AuthRequest";
+	uint64_t id = session.conn.id;
+
+	if (strcmp(msg, prefixKemRequest) == 0) {
+		countEvent(Counter::RequestKemRequest);
+		onKemRequest(session);
+	}
+	else if (strncmp(msg, prefixCipher, strlen(prefixCipher)) == 0) {
+		countEvent(Counter::RequestKemCipher);
+		// Decode the hex payload straight from the read buffer
+		uint8_t ciphertext[PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES];
+		if (!hexToBytes(string_view(msg + strlen(prefixCipher)), span<uint8_t>(ciphertext))) {
+			countEvent(Counter::HexDecodeFailures);
+			logWrite(LogLevel::Error, id, "Invalid ciphertext format.");
+			closeConnection(id);
+			return;
+		}
+		onKemCipher(session, ciphertext);
+	}
+	else if (strncmp(msg, prefixAES, strlen(prefixAES)) == 0) {
+		countEvent(Counter::RequestConfidentialData);
+		// 1) Split "<iv>:<ct>" without copying
+		char* payload = msg + strlen(prefixAES);
+		char* sep = strchr(payload, ':');
+		if (!sep) {
+			logWrite(LogLevel::Error, id, "Invalid hex format.");
+			closeConnection(id);
+			return;
+		}
+		string_view ivHex(payload, static_cast<size_t>(sep - payload));
+		string_view ctHex(sep + 1);
+
+		// 2) Decode hex; the ciphertext is decoded in place over its own hex
+		uint8_t iv[AESCTR_NONCEBYTES];
+		span<uint8_t> ct(reinterpret_cast<uint8_t*>(sep + 1), ctHex.size() / 2);
+		if (!hexToBytes(ivHex, span<uint8_t>(iv)) || !hexToBytes(ctHex, ct)) {
+			countEvent(Counter::HexDecodeFailures);
+			logWrite(LogLevel::Error, id, "Invalid hex format.");
+			closeConnection(id);
+			return;
+		}
+		onConfidentialData(session, iv, ct.data(), ct.size());
+	}
+	else if (strcmp(msg, prefixAuthRequest) == 0) {
+		countEvent(Counter::RequestAuthRequest);
+		onAuthRequest(session);
+	}
+	else {
+		// truly unknown (the firmware's text Ack only gets logged)
+		countEvent(strcmp(msg, "Ack") == 0 ? Counter::RequestAck : Counter::RequestUnknown);
+		logWrite(LogLevel::Info, id, "Client: [%s]", msg);
+	}
+}
+
+void Server::handleFrame(Session& session, const Frame& frame) {
+	uint64_t id = session.conn.id;
+	switch (frame.type) {
+	case FrameType::KemRequest:
+		countEvent(Counter::RequestKemRequest);
+		onKemRequest(session);
+		break;
+	case FrameType::KemCipher:
+		countEvent(Counter::RequestKemCipher);
+		if (frame.length != PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES) {
+			logWrite(LogLevel::Error, id, "Invalid ciphertext format.");
+			closeConnection(id);
+			return;
+		}
+		onKemCipher(session, frame.payload);
+		break;
+	case FrameType::ConfidentialData:
+		countEvent(Counter::RequestConfidentialData);
+		if (frame.length < AESCTR_NONCEBYTES) {
+			logWrite(LogLevel::Error, id, "ConfidentialData frame too short.");
+			closeConnection(id);
+			return;
+		}
+		onConfidentialData(session, frame.payload,
+			frame.payload + AESCTR_NONCEBYTES, frame.length - AESCTR_NONCEBYTES);
+		break;
+	case FrameType::AuthRequest:
+		countEvent(Counter::RequestAuthRequest);
+		onAuthRequest(session);
+		break;
+	case FrameType::Ack:
+		countEvent(Counter::RequestAck);
+		logWrite(LogLevel::Info, id, "Client: [Ack]");
+		break;
+	default:
+		countEvent(Counter::RequestUnknown);
+		logWrite(LogLevel::Info, id, "Client: [frame type %d]", static_cast<int>(frame.type));
+		break;
+	}
+}
+
+void Server::sendKemInit(Session& session, const uint8_t* pk, const char* pkHex) {
+	Connection& conn = session.conn;
+	conn.state = ConnState::KemOffered;
+	if (conn.mode == WireMode::Binary) {
+		appendFrame(conn.outBuf, FrameType::KemInit, pk, PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES);
+	}
+	else {
+		conn.outBuf.append("KemInit:");
+		conn.outBuf.append(pkHex, PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES * 2);
+	}
+	if (!flushOutput(conn)) {
+		logWrite(LogLevel::Error, conn.id, "send(KemInit) failed.");
+		closeConnection(conn.id);
+	}
+}
+
+void Server::onKemRequest(Session& session) {
+	uint64_t id = session.conn.id;
+	// Fast path: hand out a pre‑generated, pre‑encoded keypair
+	if (keypairs) {
+		KemKeypair keypair;
+		if (keypairs->take(keypair)) {
+			keypairsDry = false;
+			memcpy(session.kemPk, keypair.pk, sizeof(session.kemPk));
+			memcpy(session.kemSk, keypair.sk, sizeof(session.kemSk));
+			secureZero(keypair.sk, sizeof(keypair.sk));
+			sendKemInit(session, keypair.pk, keypair.pkHex);
+			return;
+		}
+		if (!keypairsDry) {
+			logWrite(LogLevel::Warning, id, "KEM keypair pool ran dry, generating on workers.");
+			keypairsDry = true;
+		}
+	}
+	bool binary = session.conn.mode == WireMode::Binary;
+	dispatch(session, [this, id, binary] {
+		// Step 1: Generate KEM key pair (worker thread)
+		array<uint8_t, PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES> pk;
+		array<uint8_t, PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES> sk;
+		uint64_t started = metricsNow();
+		int rc = PQCLEAN_MLKEM512_CLEAN_crypto_kem_keypair(pk.data(), sk.data());
+		recordDuration(Timer::KemKeygen, metricsNow() - started);
+		// Step 2: Hex‑encode public key (text clients only)
+		string pkHex = rc == 0 && !binary ? bytesToHex(pk.data(), pk.size()) : string();
+		postCompletion([this, id, rc, pk, sk, pkHex = move(pkHex)] {
+			Session* session = finishJob(id);
+			if (!session) {
+				return;
+			}
+			if (rc != 0) {
+				logWrite(LogLevel::Error, id, "KEM key generation failed.");
+				closeConnection(id);
+				return;
+			}
+			memcpy(session->kemPk, pk.data(), sizeof(session->kemPk));
+			memcpy(session->kemSk, sk.data(), sizeof(session->kemSk));
+			// Step 3: Send KemInit
+			sendKemInit(*session, pk.data(), pkHex.data());
+		});
+	});
+}
+
+void Server::onKemCipher(Session& session, const uint8_t* ciphertext) {
+	uint64_t id = session.conn.id;
+	if (session.conn.state != ConnState::KemOffered) {
+		logWrite(LogLevel::Error, id, "KemCipher without KemRequest.");
+		closeConnection(id);
+		return;
+	}
+	// The job works on copies: the session may close while it runs
+	array<uint8_t, PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES> ct;
+	array<uint8_t, PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES> sk;
+	memcpy(ct.data(), ciphertext, ct.size());
+	memcpy(sk.data(), session.kemSk, sk.size());
+	dispatch(session, [this, id, ct, sk] {
+		// Step 1: Decapsulate to shared secret (worker thread)
+		array<uint8_t, PQCLEAN_MLKEM512_CLEAN_CRYPTO_BYTES> ss{};
+		uint64_t started = metricsNow();
+		int rc = PQCLEAN_MLKEM512_CLEAN_crypto_kem_dec(ss.data(), ct.data(), sk.data());
+		// Step 2: Expand the AES‑256 key schedule once for this session
+		aes256ctx aes{};
+		if (rc == 0) {
+			aes256_ctr_keyexp(&aes, ss.data());
+		}
+		recordDuration(Timer::KemDecaps, metricsNow() - started);
+		postCompletion([this, id, rc, ss, aes]() mutable {
+			Session* session = finishJob(id);
+			if (!session) {
+				if (rc == 0) {
+					aes256_ctx_release(&aes);
+				}
+				return;
+			}
+			if (rc != 0) {
+				logWrite(LogLevel::Error, id, "KEM decapsulation failed.");
+				closeConnection(id);
+				return;
+			}
+			memcpy(session->sharedSecret, ss.data(), sizeof(session->sharedSecret));
+			session->setAes(aes);
+			session->conn.state = ConnState::KeyEstablished;
+			logWrite(LogLevel::Info, id, "Shared secret established.");
+		});
+	});
+}
+
+void Server::onConfidentialData(Session& session, const uint8_t* iv, const uint8_t* ct, size_t ctLen) {
+	Connection& conn = session.conn;
+	if (conn.state != ConnState::KeyEstablished) {
+		logWrite(LogLevel::Error, conn.id, "ConfidentialData before key exchange.");
+		closeConnection(conn.id);
+		return;
+	}
+	recordDuration(Timer::Handshake, metricsNow() - conn.acceptedNs);
+
+	// 1) Decrypt with the session's expanded AES‑256 key
+
+	//  Generate keystream again (same IV/key)
+	std::vector<uint8_t> keystream(ctLen);
+	aes256_ctr(keystream.data(), ctLen, iv, &session.aes);
+
+	//  XOR ciphertext with keystream to recover plaintext
+	std::vector<uint8_t> pt(ctLen);
+	for (size_t i = 0; i < ctLen; ++i) {
+		pt[i] = ct[i] ^ keystream[i];
+	}
+
+	//  Log it
+	logWrite(LogLevel::Info, conn.id, "Decrypted message: %.*s", static_cast<int>(pt.size()),
+		reinterpret_cast<const char*>(pt.data()));
+
+	// The exchange is complete: close once pending output is flushed
+	conn.state = ConnState::Closing;
+	if (conn.outBuf.empty()) {
+		closeConnection(conn.id);
+	}
+}
+
+void Server::onAuthRequest(Session& session) {
+	Connection& conn = session.conn;
+	bool binary = conn.mode == WireMode::Binary;
+	// Step 1: Prepare timestamped reply; signing waits for the next batch
+	time_t now = time(nullptr);
+	if (authCache) {
+		// Serve the reply already signed for this second
+		if (const string* cached = authCache->find(now, binary)) {
+			if (!queueSend(conn, *cached)) {
+				logWrite(LogLevel::Error, conn.id, "send(AuthReply) failed.");
+				closeConnection(conn.id);
+			}
+			return;
+		}
+		// Only the first requester of a second starts a signature
+		if (authCache->join(now, conn.id, binary)) {
+			pendingAuth.push_back({ 0, binary, "AuthReply:" + to_string(now), now, true });
+		}
+	}
+	else {
+		pendingAuth.push_back({ conn.id, binary, "AuthReply:" + to_string(now), now, false });
+	}
+	// Keep per‑connection ordering: read nothing more until the reply is signed
+	conn.busy = true;
+	updateInterest(conn);
+}
+
+/**
+ * @brief Encode a signed AuthReply as "<plain>|signature:<hex>" or a binary frame.
+ */
+static string formatAuthReply(const string& plain, bool binary, const uint8_t* signature, size_t sigLen) {
+	string reply;
+	if (binary) {
+		appendFrameHeader(reply, FrameType::AuthReply, plain.size() + sigLen);
+		reply.append(plain);
+		reply.append(reinterpret_cast<const char*>(signature), sigLen);
+		return reply;
+	}
+	// Hex‑encode the signature directly behind the message
+	reply.reserve(plain.size() + 11 + sigLen * 2);
+	reply.append(plain);
+	reply.append("|signature:");
+	size_t at = reply.size();
+	reply.resize(at + sigLen * 2);
+	bytesToHex(span<const uint8_t>(signature, sigLen), span<char>(reply.data() + at, sigLen * 2));
+	return reply;
+}
+
+void Server::flushAuthBatches() {
+	// Spread queued requests over the workers, at most authBatchMax per job
+	size_t total = pendingAuth.size();
+	size_t jobs = (total + config.authBatchMax - 1) / config.authBatchMax;
+	jobs = max(jobs, min(pool->size(), total));
+	size_t perJob = (total + jobs - 1) / jobs;
+	for (size_t first = 0; first < total; first += perJob) {
+		auto begin = pendingAuth.begin() + first;
+		auto end = pendingAuth.begin() + min(first + perJob, total);
+		signAuthBatch(vector<PendingAuth>(make_move_iterator(begin), make_move_iterator(end)));
+	}
+	pendingAuth.clear();
+}
+
+void Server::signAuthBatch(vector<PendingAuth> batch) {
+	vector<PendingAuth> heads;
+	heads.reserve(batch.size());
+	for (const PendingAuth& request : batch) {
+		heads.push_back({ request.id, request.binary, string(), request.second, request.cacheFill });
+	}
+	bool queued = pool->trySubmit([this, batch = move(batch)]() mutable {
+		// Step 2: Sign all replies with the prepared Dilithium key (worker thread)
+		size_t count = batch.size();
+		vector<const uint8_t*> messages(count);
+		vector<size_t> messageLens(count);
+		vector<size_t> sigLens(count);
+		vector<uint8_t> signatures(count * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES);
+		for (size_t i = 0; i < count; ++i) {
+			messages[i] = reinterpret_cast<const uint8_t*>(batch[i].plain.data());
+			messageLens[i] = batch[i].plain.size();
+		}
+		uint64_t started = metricsNow();
+		int rc = PQCLEAN_MLDSA44_CLEAN_crypto_sign_signature_batch(signatures.data(), sigLens.data(),
+			messages.data(), messageLens.data(), count, signer.get());
+		// One sample per signature, each charged the batch's mean
+		uint64_t perSignature = (metricsNow() - started) / max<size_t>(count, 1);
+		for (size_t i = 0; i < count; ++i) {
+			recordDuration(Timer::Sign, perSignature);
+		}
+		// Step 3: Encode every reply for its connection's wire mode (both for the cache)
+		vector<string> replies(count);
+		vector<string> binaryReplies(count);
+		for (size_t i = 0; rc == 0 && i < count; ++i) {
+			const uint8_t* signature = signatures.data() + i * PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
+			replies[i] = formatAuthReply(batch[i].plain, batch[i].binary && !batch[i].cacheFill,
+				signature, sigLens[i]);
+			if (batch[i].cacheFill) {
+				binaryReplies[i] = formatAuthReply(batch[i].plain, true, signature, sigLens[i]);
+			}
+		}
+		postCompletion([this, rc, batch = move(batch), replies = move(replies),
+			binaryReplies = move(binaryReplies)] {
+			for (size_t i = 0; i < batch.size(); ++i) {
+				if (batch[i].cacheFill) {
+					sendCachedAuth(batch[i].second, rc == 0 ? &replies[i] : nullptr,
+						rc == 0 ? &binaryReplies[i] : nullptr);
+					continue;
+				}
+				uint64_t id = batch[i].id;
+				Session* session = finishJob(id);
+				if (!session) {
+					continue;
+				}
+				if (rc != 0) {
+					logWrite(LogLevel::Error, id, "Signature failed.");
+					closeConnection(id);
+					continue;
+				}
+				// Step 4: Send the signed reply
+				if (!queueSend(session->conn, replies[i])) {
+					logWrite(LogLevel::Error, id, "send(AuthReply) failed.");
+					closeConnection(id);
+				}
+			}
+		});
+	});
+	if (!queued) {
+		// Shed load rather than block the network thread
+		logWrite(LogLevel::Error, NO_SESSION, "Crypto job queue full, dropping %zu client(s).", heads.size());
+		for (const PendingAuth& request : heads) {
+			if (request.cacheFill) {
+				sendCachedAuth(request.second, nullptr, nullptr);
+			}
+			else {
+				closeConnection(request.id);
+			}
+		}
+	}
+}
+
+void Server::sendCachedAuth(time_t second, const string* text, const string* binary) {
+	for (const AuthReplyCache::Waiter& waiter : authCache->complete(second, text, binary)) {
+		Session* session = finishJob(waiter.id);
+		if (!session) {
+			continue;
+		}
+		if (!text || !binary) {
+			logWrite(LogLevel::Error, waiter.id, "Signature failed.");
+			closeConnection(waiter.id);
+			continue;
+		}
+		if (!queueSend(session->conn, waiter.binary ? *binary : *text)) {
+			logWrite(LogLevel::Error, waiter.id, "send(AuthReply) failed.");
+			closeConnection(waiter.id);
+		}
+	}
+}
+
+bool Server::dispatch(Session& session, WorkerPool::Job job) {
+	if (!pool->trySubmit(move(job))) {
+		// Shed load rather than block the network thread
+		logWrite(LogLevel::Error, session.conn.id, "Crypto job queue full, dropping client.");
+		closeConnection(session.conn.id);
+		return false;
+	}
+	// Keep per‑connection ordering: read nothing more until the job is done
+	session.conn.busy = true;
+	updateInterest(session.conn);
+	return true;
+}
+
+void Server::postCompletion(Completion done) {
+	{
+		lock_guard<mutex> lock(completionMutex);
+		completions.push_back(move(done));
+	}
+	uint64_t one = 1;
+	ssize_t rc = write(wakeFd, &one, sizeof(one));
+	(void)rc; // counter saturation still leaves the eventfd readable
+}
+
+void Server::runCompletions() {
+	uint64_t count;
+	ssize_t rc = read(wakeFd, &count, sizeof(count));
+	(void)rc;
+	vector<Completion> ready;
+	{
+		lock_guard<mutex> lock(completionMutex);
+		ready.swap(completions);
+	}
+	for (auto& done : ready) {
+		done();
+	}
+	// Parse input that was pipelined behind the finished jobs
+	for (uint64_t id : resumed) {
+		Session* session = sessions.find(id);
+		if (session && session->conn.inBuf.size() > 0) {
+			processInput(*session);
+		}
+	}
+	resumed.clear();
+}
+
+Session* Server::finishJob(uint64_t id) {
+	Session* session = sessions.find(id);
+	if (!session) {
+		return nullptr;
+	}
+	session->conn.busy = false;
+	updateInterest(session->conn);
+	resumed.push_back(id);
+	return session;
+}
+
+bool Server::queueSend(Connection& conn, std::string_view data) {
+	conn.outBuf.append(data);
+	return flushOutput(conn);
+}
+
+bool Server::flushOutput(Connection& conn) {
+	size_t sent = 0;
+	while (sent < conn.outBuf.size()) {
+		ssize_t n = send(conn.fd, conn.outBuf.data() + sent, conn.outBuf.size() - sent, MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+			return false;
+		}
+		sent += static_cast<size_t>(n);
+	}
+	conn.outBuf.erase(0, sent);
+	countEvent(Counter::BytesSent, sent);
+	updateInterest(conn);
+	return true;
+}
+
+void Server::handleWritable(Session& session) {
+	Connection& conn = session.conn;
+	if (!flushOutput(conn)) {
+		logWrite(LogLevel::Error, conn.id, "send() failed. Code: %d", errno);
+		closeConnection(conn.id);
+		return;
+	}
+	if (conn.state == ConnState::Closing && conn.outBuf.empty()) {
+		closeConnection(conn.id);
+	}
+}
+
+void Server::updateInterest(Connection& conn) {
+	// Read unless a job is pending; poll for writability only with pending output
+	uint32_t want = (conn.busy ? 0u : static_cast<uint32_t>(EPOLLIN)) |
+		(conn.outBuf.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+	if (want == conn.events) {
+		return;
+	}
+	epoll_event ev{};
+	ev.events = want;
+	ev.data.u64 = conn.id;
+	if (epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.fd, &ev) == 0) {
+		conn.events = want;
+	}
+}
+
+void Server::closeConnection(uint64_t id) {
+	Session* session = sessions.find(id);
+	if (!session) {
+		return;
+	}
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, session->conn.fd, nullptr);
+	close(session->conn.fd);
+	sessions.release(*session);
+	countEvent(Counter::ConnectionsClosed);
+	logWrite(LogLevel::Debug, id, "Connection closed.");
+}
@@ -0,0 +1,206 @@
+﻿// Server.hpp
+/**
+ * @file Server.hpp
+ * @brief Non‑blocking epoll reactor serving the KEM / AES / Auth protocol.
+ */
+
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <cstdint>        ///< for uint8_t, uint16_t
+#include <ctime>          ///< for time_t
+#include <functional>     ///< for std::function
+#include <memory>         ///< for std::unique_ptr
+#include <mutex>          ///< for completion queue lock
+#include <string>         ///< for std::string
+#include <string_view>    ///< for std::string_view
+#include <vector>         ///< for completion queue
+#include "AuthReplyCache.hpp"
+#include "KeypairPool.hpp"
+#include "Log.hpp"
+#include "MetricsServer.hpp"
+#include "Protocol.hpp"
+#include "Session.hpp"
+#include "WorkerPool.hpp"
+
+extern "C" {
+#include "PQClean-master/crypto_sign/ml-dsa-44/clean/api.h"   ///< ML-DSA signing context
+}
+
+/**
+ * @brief Tunables for the server, filled from the command line.
+ */
+struct ServerConfig {
+	uint16_t port = 8080;           ///< TCP port to listen on
+	size_t workerThreads = 0;       ///< Crypto worker threads (0 = one per core)
+	size_t jobQueueCapacity = 1024; ///< Maximum queued crypto jobs
+	size_t kemPoolLow = 64;         ///< Refill the KEM keypair pool below this
+	size_t kemPoolHigh = 256;       ///< KEM keypair pool capacity (0 = no pool)
+	size_t authBatchMax = 16;       ///< Most AuthReplies signed by one worker job
+	bool authCache = false;         ///< Share one signed AuthReply per second
+	bool ctxPool = true;            ///< Serve PQClean heap contexts from the slab pool
+	uint16_t metricsPort = 0;       ///< HTTP port for Prometheus metrics (0 = off)
+	LogLevel logLevel = LogLevel::Info; ///< Least severe log level written
+};
+
+/**
+ * @brief Single‑threaded epoll event loop handling many clients at once.
+ *
+ * Every socket is non‑blocking; a slow client never stalls the others.
+ * Each client owns a Session holding its protocol state machine (see
+ * ConnState) and its own KEM keys, so concurrent handshakes are independent.
+ * The network thread only parses messages: key generation, decapsulation
+ * and signing run on a WorkerPool and report back through a completion
+ * queue that wakes the loop via an eventfd. AuthRequests parsed in one
+ * loop round are signed together in batches with a signing key that was
+ * unpacked and expanded once at startup. KemRequest is normally served
+ * straight from a KeypairPool of pre‑generated keys; only when that pool
+ * runs dry is key generation dispatched to the workers.
+ */
+class Server {
+public:
+	/**
+	 * @brief Construct a server bound to the given signing key.
+	 * @param signSk ML‑DSA secret key used for AuthReply signatures (not copied).
+	 * @param config Listening port and worker pool sizing.
+	 */
+	Server(const uint8_t* signSk, const ServerConfig& config);
+	~Server();
+
+	Server(const Server&) = delete;
+	Server& operator=(const Server&) = delete;
+
+	/**
+	 * @brief Create the listening socket, epoll instance, signal handling
+	 *        and the crypto worker pool.
+	 * @return True on success; false if any step failed (reason printed).
+	 */
+	bool start();
+
+	/**
+	 * @brief Run the event loop until SIGINT or SIGTERM is received.
+	 * @return 0 on clean shutdown; nonzero on fatal error.
+	 */
+	int run();
+
+private:
+	using Completion = std::function<void()>;
+
+	void acceptClients();
+	void handleReadable(Session& session);
+	void handleWritable(Session& session);
+
+	/**
+	 * @brief Handle every complete message in the session's read buffer.
+	 *
+	 * Stops early while a crypto job is pending; the remaining bytes stay
+	 * buffered and are parsed once the job completes.
+	 */
+	void processInput(Session& session);
+
+	/**
+	 * @brief Extract and handle one newline‑terminated text message.
+	 * @return False if no complete line is buffered or the session was closed.
+	 */
+	bool nextLine(Session& session);
+
+	/**
+	 * @brief Extract and handle one binary frame.
+	 * @return False if no complete frame is buffered or the session was closed.
+	 */
+	bool nextFrame(Session& session);
+
+	void handleMessage(Session& session, char* msg);
+	void handleFrame(Session& session, const Frame& frame);
+
+	// Verb handlers shared by the text and binary protocols
+	void onKemRequest(Session& session);
+	void onKemCipher(Session& session, const uint8_t* ciphertext);
+	void onConfidentialData(Session& session, const uint8_t* iv, const uint8_t* ct, size_t ctLen);
+	void onAuthRequest(Session& session);
+	void sendKemInit(Session& session, const uint8_t* pk, const char* pkHex);
+
+	/**
+	 * @brief An AuthRequest waiting to be signed in the next batch.
+	 */
+	struct PendingAuth {
+		uint64_t id;       ///< Session that asked
+		bool binary;       ///< Reply as a binary frame instead of hex text
+		std::string plain; ///< "AuthReply:<time>" message to sign
+		time_t second;     ///< Timestamp bound by plain
+		bool cacheFill;    ///< Signs a second for the AuthReplyCache (id unused)
+	};
+
+	/**
+	 * @brief Split the AuthRequests queued during one loop round into batch jobs.
+	 */
+	void flushAuthBatches();
+
+	/**
+	 * @brief Sign a batch of AuthReplies in one worker job.
+	 *
+	 * All sessions in the batch are closed if the job queue is full.
+	 */
+	void signAuthBatch(std::vector<PendingAuth> batch);
+
+	/**
+	 * @brief Cache a freshly signed second and answer everyone waiting for it.
+	 * @param text   Hex text reply, or nullptr if signing failed (waiters are closed).
+	 * @param binary Binary frame reply, or nullptr if signing failed.
+	 */
+	void sendCachedAuth(time_t second, const std::string* text, const std::string* binary);
+
+	/**
+	 * @brief Hand a crypto job to the worker pool and pause input on the session.
+	 * @return False if the job queue is full (the session is closed).
+	 */
+	bool dispatch(Session& session, WorkerPool::Job job);
+
+	/**
+	 * @brief Queue a callback to run on the network thread (thread‑safe).
+	 */
+	void postCompletion(Completion done);
+	void runCompletions();
+
+	/**
+	 * @brief Look up a live session and resume its input after a job.
+	 * @return The session, or nullptr if it was closed meanwhile.
+	 */
+	Session* finishJob(uint64_t id);
+
+	/**
+	 * @brief Send as much of data as possible, buffering the remainder.
+	 * @return False if the socket failed and the connection must be closed.
+	 */
+	bool queueSend(Connection& conn, std::string_view data);
+	bool flushOutput(Connection& conn);
+	void updateInterest(Connection& conn);
+	void closeConnection(uint64_t id);
+
+	const uint8_t* signSk;
+	ServerConfig config;
+	int listenFd = -1;
+	int epollFd = -1;
+	int signalFd = -1;
+	int wakeFd = -1;
+	SessionPool sessions;
+
+	std::mutex completionMutex;
+	std::vector<Completion> completions;
+	std::vector<uint64_t> resumed;   ///< Sessions whose job finished in this batch
+
+	std::unique_ptr<PQCLEAN_MLDSA44_CLEAN_signer, void (*)(PQCLEAN_MLDSA44_CLEAN_signer*)> signer{
+		nullptr, PQCLEAN_MLDSA44_CLEAN_crypto_sign_signer_free };
+	std::vector<PendingAuth> pendingAuth;
+	std::unique_ptr<AuthReplyCache> authCache;   ///< Only with ServerConfig::authCache
+
+	std::unique_ptr<KeypairPool> keypairs;
+	bool keypairsDry = false;
+
+	std::unique_ptr<WorkerPool> pool;
+	bool ctxPoolInstalled = false;   ///< The PQClean slab allocator is active
+
+	std::unique_ptr<MetricsServer> metrics;   ///< Only with ServerConfig::metricsPort
+};
+
+#endif // SERVER_HPP
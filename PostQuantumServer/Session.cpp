@@ -0,0 +1,95 @@
+// Session.cpp
+/**
+ * @file Session.cpp
+ * @brief Implementation of per‑client sessions and the session slab.
+ */
+
+#include "Session.hpp"
+#include "Helpers.hpp"
+
+#include <utility>
+
+/** Receive buffers up to this size are kept for the slot's next client. */
+const size_t READ_BUFFER_KEEP = 16 * 1024;
+
+void Session::setAes(const aes256ctx& ctx) {
+	if (aesReady) {
+		aes256_ctx_release(&aes);
+	}
+	aes = ctx;
+	aesReady = true;
+}
+
+void Session::reset() {
+	if (aesReady) {
+		aes256_ctx_release(&aes);
+		aesReady = false;
+	}
+	secureZero(kemSk, sizeof(kemSk));
+	secureZero(sharedSecret, sizeof(sharedSecret));
+	uint64_t id = conn.id;
+	ReadBuffer inBuf = std::move(conn.inBuf);
+	inBuf.shrink(READ_BUFFER_KEEP);
+	conn = Connection{};
+	conn.id = id;
+	conn.inBuf = std::move(inBuf);
+}
+
+SessionPool::SessionPool(size_t reserve) {
+	while (slotCount < reserve) {
+		grow();
+	}
+}
+
+SessionPool::~SessionPool() {
+	forEach([](Session& session) { session.reset(); });
+}
+
+void SessionPool::grow() {
+	chunks.emplace_back(new Slot[CHUNK_SLOTS]);
+	// Push in reverse so low indices are handed out first
+	freeSlots.reserve(freeSlots.size() + CHUNK_SLOTS);
+	for (uint32_t i = CHUNK_SLOTS; i > 0; --i) {
+		freeSlots.push_back(slotCount + i - 1);
+	}
+	slotCount += CHUNK_SLOTS;
+}
+
+Session& SessionPool::acquire() {
+	if (freeSlots.empty()) {
+		grow();
+	}
+	uint32_t index = freeSlots.back();
+	freeSlots.pop_back();
+	Slot& slot = slotAt(index);
+	slot.live = true;
+	slot.session.conn.id = (static_cast<uint64_t>(slot.generation) << 32) | index;
+	++activeCount;
+	return slot.session;
+}
+
+Session* SessionPool::find(uint64_t id) {
+	uint32_t index = static_cast<uint32_t>(id);
+	uint32_t generation = static_cast<uint32_t>(id >> 32);
+	if (index >= slotCount) {
+		return nullptr;
+	}
+	Slot& slot = slotAt(index);
+	if (!slot.live || slot.generation != generation) {
+		return nullptr;
+	}
+	return &slot.session;
+}
+
+void SessionPool::release(Session& session) {
+	uint32_t index = static_cast<uint32_t>(session.conn.id);
+	Slot& slot = slotAt(index);
+	session.reset();
+	slot.live = false;
+	// Skip generation 0 on wrap‑around so ids stay above the reserved range
+	if (++slot.generation == 0) {
+		slot.generation = 1;
+	}
+	freeSlots.push_back(index);
+	--activeCount;
+}
@@ -0,0 +1,120 @@
+// Session.hpp
+/**
+ * @file Session.hpp
+ * @brief Per‑client key material and the slab allocator that owns it.
+ */
+
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include <cstddef>   ///< for size_t
+#include <cstdint>   ///< for uint8_t, uint32_t, uint64_t
+#include <memory>    ///< for std::unique_ptr
+#include <vector>    ///< for slab chunks and free list
+#include "Connection.hpp"
+
+extern "C" {
+#include "PQClean-master/crypto_kem/ml-kem-512/clean/api.h"   ///< ML-KEM sizes
+#include "aes.h"                                             ///< AES‑256‑CTR
+}
+
+/**
+ * @brief Everything the server knows about one client.
+ *
+ * Holds the socket/protocol state together with the client's own ephemeral
+ * ML‑KEM keypair, the derived shared secret and the AES‑256 context expanded
+ * from it, so concurrent handshakes never share key material.
+ */
+struct Session {
+	Connection conn;                                           ///< Socket and protocol state (conn.id is the session id)
+	uint8_t kemPk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES]; ///< Ephemeral KEM public key
+	uint8_t kemSk[PQCLEAN_MLKEM512_CLEAN_CRYPTO_SECRETKEYBYTES]; ///< Ephemeral KEM secret key
+	uint8_t sharedSecret[PQCLEAN_MLKEM512_CLEAN_CRYPTO_BYTES];  ///< KEM shared secret
+	aes256ctx aes{};                                           ///< AES key schedule from sharedSecret
+	bool aesReady = false;                                     ///< aes holds an expanded key
+
+	/**
+	 * @brief Install a freshly expanded AES context, releasing any previous one.
+	 */
+	void setAes(const aes256ctx& ctx);
+
+	/**
+	 * @brief Wipe all key material and return the session to its idle state.
+	 */
+	void reset();
+};
+
+/**
+ * @brief Slab allocator for Session objects with O(1) lookup by id.
+ *
+ * Sessions live in fixed‑size chunks, so pointers stay valid while the pool
+ * grows. An id encodes the slot index (low 32 bits) and a per‑slot
+ * generation (high 32 bits), so ids of released sessions never resolve to
+ * the slot's next occupant. Ids are always >= 2^32.
+ */
+class SessionPool {
+public:
+	/**
+	 * @brief Create a pool, pre‑allocating room for the given number of sessions.
+	 */
+	explicit SessionPool(size_t reserve = 0);
+	~SessionPool();
+
+	SessionPool(const SessionPool&) = delete;
+	SessionPool& operator=(const SessionPool&) = delete;
+
+	/**
+	 * @brief Take a free session; its conn.id is already assigned.
+	 */
+	Session& acquire();
+
+	/**
+	 * @brief Find a live session.
+	 * @return The session, or nullptr if id is stale or unknown.
+	 */
+	Session* find(uint64_t id);
+
+	/**
+	 * @brief Wipe a session and return its slot to the free list.
+	 */
+	void release(Session& session);
+
+	/**
+	 * @brief Number of sessions currently handed out.
+	 */
+	size_t active() const { return activeCount; }
+
+	/**
+	 * @brief Call fn(Session&) for every live session.
+	 */
+	template <typename Fn>
+	void forEach(Fn fn) {
+		for (uint32_t index = 0; index < slotCount; ++index) {
+			Slot& slot = slotAt(index);
+			if (slot.live) {
+				fn(slot.session);
+			}
+		}
+	}
+
+private:
+	struct Slot {
+		Session session;
+		uint32_t generation = 1;
+		bool live = false;
+	};
+
+	static constexpr uint32_t CHUNK_SLOTS = 1024;
+
+	Slot& slotAt(uint32_t index) {
+		return chunks[index / CHUNK_SLOTS][index % CHUNK_SLOTS];
+	}
+	void grow();
+
+	std::vector<std::unique_ptr<Slot[]>> chunks;
+	std::vector<uint32_t> freeSlots;
+	uint32_t slotCount = 0;
+	size_t activeCount = 0;
+};
+
+#endif // SESSION_HPP
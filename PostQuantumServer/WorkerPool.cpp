@@ -0,0 +1,67 @@
+// WorkerPool.cpp
+/**
+ * @file WorkerPool.cpp
+ * @brief Implementation of the bounded crypto worker pool.
+ */
+
+#include "WorkerPool.hpp"
+
+#include "ctxalloc.h"
+
+WorkerPool::WorkerPool(size_t threads, size_t capacity)
+	: capacity(capacity) {
+	if (threads == 0) {
+		threads = 1;
+	}
+	workers.reserve(threads);
+	for (size_t i = 0; i < threads; ++i) {
+		workers.emplace_back(&WorkerPool::workerLoop, this);
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		queue.clear();
+	}
+	cv.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+bool WorkerPool::trySubmit(Job job) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stopping || queue.size() >= capacity) {
+			return false;
+		}
+		queue.push_back(std::move(job));
+	}
+	cv.notify_one();
+	return true;
+}
+
+void WorkerPool::workerLoop() {
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [this] { return stopping || !queue.empty(); });
+			if (stopping) {
+				return;
+			}
+			job = std::move(queue.front());
+			queue.pop_front();
+		}
+		// Count heap contexts per job so a malloc on the hot path shows up
+		pqclean_alloc_stats before;
+		pqclean_alloc_stats after;
+		pqclean_alloc_thread_stats(&before);
+		job();
+		pqclean_alloc_thread_stats(&after);
+		ctxAllocCount.fetch_add(after.allocs - before.allocs, std::memory_order_relaxed);
+		jobCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,77 @@
+// WorkerPool.hpp
+/**
+ * @file WorkerPool.hpp
+ * @brief Fixed‑size thread pool with a bounded job queue for crypto work.
+ */
+
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>              ///< for job statistics
+#include <condition_variable>  ///< for std::condition_variable
+#include <cstddef>             ///< for size_t
+#include <cstdint>             ///< for uint64_t
+#include <deque>               ///< for job queue
+#include <functional>          ///< for std::function
+#include <mutex>               ///< for std::mutex
+#include <thread>              ///< for std::thread
+#include <vector>              ///< for worker list
+
+/**
+ * @brief Runs ML‑KEM / ML‑DSA operations off the network thread.
+ *
+ * Jobs are executed in FIFO order by a fixed number of threads. The queue
+ * is bounded: when it is full, trySubmit() fails instead of blocking, so
+ * the caller can shed load without stalling its event loop.
+ */
+class WorkerPool {
+public:
+	using Job = std::function<void()>;
+
+	/**
+	 * @brief Start the worker threads.
+	 * @param threads  Number of worker threads (at least one is started).
+	 * @param capacity Maximum number of queued, not yet running jobs.
+	 */
+	WorkerPool(size_t threads, size_t capacity);
+
+	/**
+	 * @brief Stop accepting jobs, discard queued ones and join all workers.
+	 */
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/**
+	 * @brief Enqueue a job without blocking.
+	 * @param job Callable executed on a worker thread.
+	 * @return True if queued; false if the queue is full or the pool stopped.
+	 */
+	bool trySubmit(Job job);
+
+	/**
+	 * @brief Number of worker threads.
+	 */
+	size_t size() const { return workers.size(); }
+
+	/** @brief Number of jobs that have finished running. */
+	uint64_t jobsRun() const { return jobCount.load(std::memory_order_relaxed); }
+
+	/** @brief PQClean context allocations made while running those jobs. */
+	uint64_t ctxAllocations() const { return ctxAllocCount.load(std::memory_order_relaxed); }
+
+private:
+	void workerLoop();
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<Job> queue;
+	std::vector<std::thread> workers;
+	size_t capacity;
+	bool stopping = false;
+	std::atomic<uint64_t> jobCount{ 0 };
+	std::atomic<uint64_t> ctxAllocCount{ 0 };
+};
+
+#endif // WORKER_POOL_HPP
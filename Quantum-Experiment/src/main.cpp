@@ -6,6 +6,7 @@
 #define KEM
 #define AES
 // #define AUTH
+// #define BINARY // raw length‑prefixed frames instead of hex text
 
 /** Shared secret from KEM, used as AES key. */
 #ifdef KEM
@@ -81,7 +82,31 @@ bool connectToServer()
 
     static char response[5000]; // Buffer for server replies
 
+#ifdef BINARY
+    // Switch this connection to the binary frame protocol
+    if (!negotiateBinary()) {
+        client.stop(500);
+        return false;
+    }
+#endif // BINARY
+
 #ifdef AUTH
+#ifdef BINARY
+    Serial.println(F("-> AuthRequest (binary)"));
+    sendFrame(FRAME_AUTH_REQUEST, nullptr, 0);
+
+    if (processAuthReplyBinary(reinterpret_cast<uint8_t*>(response), sizeof(response))) {
+        Serial.println(F("Signature valid, sending Ack"));
+        sendFrame(FRAME_ACK, nullptr, 0);
+        delay(500);
+
+        Serial.print(F("Heap after auth: "));
+        Serial.println(ESP.getFreeHeap());
+    } else {
+        client.stop(500);
+        return false;
+    }
+#else
     // Send authentication request
     Serial.println(F("-> AuthRequest"));
     client.println("AuthRequest");
@@ -102,9 +127,20 @@ bool connectToServer()
         client.stop(500);
         return false;
     }
+#endif // BINARY
 #endif // AUTH
 
 #ifdef KEM
+#ifdef BINARY
+    Serial.println(F("-> KemRequest (binary)"));
+    sendFrame(FRAME_KEM_REQUEST, nullptr, 0);
+
+    if (!processKemBinary(reinterpret_cast<uint8_t*>(response), sizeof(response))) {
+        client.stop(500);
+        return false;
+    }
+    delay(200);
+#else
     // Request and process KEM encapsulation
     Serial.println(F("-> KemRequest"));
     client.println("KemRequest");
@@ -116,6 +152,7 @@ bool connectToServer()
     Serial.println(F("-> Sending KemCipher"));
     client.println(response);
     delay(200);
+#endif // BINARY
 #endif // KEM
 
 #ifdef AES
@@ -140,6 +177,16 @@ bool connectToServer()
         ciphertext[i] = uint8_t(plaintext[i]) ^ keystream[i];
     }
 
+#ifdef BINARY
+    // 4) Send as one frame: IV || ciphertext
+    Serial.println(F("-> Sending ConfidentialData (binary)"));
+    std::vector<uint8_t> payload(AESCTR_NONCEBYTES + pt_len);
+    memcpy(payload.data(), iv, AESCTR_NONCEBYTES);
+    memcpy(payload.data() + AESCTR_NONCEBYTES, ciphertext.data(), pt_len);
+    if (!sendFrame(FRAME_CONFIDENTIAL_DATA, payload.data(), payload.size())) {
+        Serial.println(F("AES: frame send failed"));
+    }
+#else
     // 4) Convert IV and ciphertext to hex
     char ivHex[AESCTR_NONCEBYTES * 2 + 1], ctHex[pt_len * 2 + 1];
     Utils::bytesToHex(iv, AESCTR_NONCEBYTES, ivHex, sizeof(ivHex));
@@ -154,6 +201,7 @@ bool connectToServer()
     } else {
         Serial.println(F("AES: sendBuf overflow"));
     }
+#endif // BINARY
     // 6) Clean up AES context
     aes256_ctx_release(&aes_ctx);
 #endif // AES
@@ -242,6 +290,47 @@ bool processKem(char* message, size_t bufferSize)
     Serial.println();
     return true;
 }
+
+#ifdef BINARY
+/**
+ * @brief Binary variant of processKem: raw KemInit frame in, raw KemCipher frame out.
+ * @param buffer    Scratch buffer for the received public key
+ * @param capacity  Size of the buffer
+ * @return true if encapsulation succeeded and the ciphertext was sent
+ */
+bool processKemBinary(uint8_t* buffer, size_t capacity)
+{
+    const size_t pkBytes = PQCLEAN_MLKEM512_CLEAN_CRYPTO_PUBLICKEYBYTES;
+    const size_t ctBytes = PQCLEAN_MLKEM512_CLEAN_CRYPTO_CIPHERTEXTBYTES;
+    size_t len = 0;
+
+    // 1) Receive the raw public key, no hex decoding needed
+    if (!readFrame(FRAME_KEM_INIT, buffer, capacity, &len) || len != pkBytes) {
+        Serial.println(F("KEM: Invalid KemInit frame."));
+        return false;
+    }
+    yield();
+
+    // 2) Encapsulate straight from the receive buffer
+    uint8_t ct[ctBytes];
+    unsigned long t0 = millis();
+    if (PQCLEAN_MLKEM512_CLEAN_crypto_kem_enc(ct, kem_shared_secret, buffer) != 0) {
+        Serial.println(F("KEM: encapsulation failed."));
+        return false;
+    }
+    unsigned long dt = millis() - t0;
+    Serial.printf("Encapsulation took %lums\n", dt);
+    yield();
+
+    // 3) Send the raw ciphertext
+    if (!sendFrame(FRAME_KEM_CIPHER, ct, ctBytes)) {
+        Serial.println(F("KEM: KemCipher send failed."));
+        return false;
+    }
+    Serial.println(F("KEM: encapsulation OK"));
+    return true;
+}
+#endif // BINARY
 #endif // KEM
 
 #ifdef AUTH
@@ -378,6 +467,73 @@ bool verifyAuthReply(const char* message, const char* signatureHex, const char*
     }
 }
 
+#ifdef BINARY
+/**
+ * @brief Receive and validate a binary AuthReply frame (message || signature).
+ * @param buffer    Scratch buffer for the frame payload
+ * @param capacity  Size of the buffer
+ * @return true if signature is valid
+ */
+bool processAuthReplyBinary(uint8_t* buffer, size_t capacity)
+{
+    const size_t sigBytes = PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES;
+    size_t len = 0;
+    if (!readFrame(FRAME_AUTH_REPLY, buffer, capacity, &len) || len <= sigBytes) {
+        Serial.println(F("Auth: Invalid AuthReply frame."));
+        return false;
+    }
+    size_t msgLen = len - sigBytes;
+
+    Serial.print(F("m‑bytes: "));
+    Serial.write(buffer, msgLen);
+    Serial.println();
+
+    // Load public key from flash and verify the raw signature
+    char* pkHex = (char*)malloc(((PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES * 2) + 1) * sizeof(char));
+    if (!pkHex) {
+        Serial.println(F("Auth: Failed to allocate memory for pkHex."));
+        return false;
+    }
+    strcpy_P(pkHex, dilithiumPublicKey);
+
+    bool valid = verifySignature(buffer, msgLen, buffer + msgLen, pkHex);
+    free(pkHex);
+    Serial.println(valid ? F("Auth: VALID.") : F("Auth: INVALID."));
+    return valid;
+}
+
+/**
+ * @brief Verify a raw ML‑DSA signature over message.
+ * @param message  Signed message bytes
+ * @param msgLen   Message length
+ * @param sig      Raw signature (PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES long)
+ * @param pkHex    Public key in hex
+ * @return true if signature valid
+ */
+bool verifySignature(const uint8_t* message, size_t msgLen, const uint8_t* sig, const char* pkHex)
+{
+    uint8_t* pk = (uint8_t*)malloc((PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES) * sizeof(uint8_t));
+    if (!pk) {
+        Serial.println(F("Failed to allocate memory for pk."));
+        return false;
+    }
+    if (!Utils::hexToBytes(pkHex, pk, PQCLEAN_MLDSA44_CLEAN_CRYPTO_PUBLICKEYBYTES)) {
+        Serial.println(F("Public key hex decode failed."));
+        free(pk);
+        return false;
+    }
+
+    unsigned long t0 = millis();
+    int ret = PQCLEAN_MLDSA44_CLEAN_crypto_sign_verify(sig, PQCLEAN_MLDSA44_CLEAN_CRYPTO_BYTES,
+        message, msgLen, pk);
+    unsigned long dt = millis() - t0;
+
+    Serial.printf("verify took %lums\n", dt);
+    free(pk);
+    return ret == SIG_VALID;
+}
+#endif // BINARY
+
 #endif // AUTH
 
 /**
@@ -423,4 +579,118 @@ bool checkResponseLength(char* response, size_t expectedLength)
         Serial.println(F("Response too short."));
         return false;
     }
-}
\ No newline at end of file
+}
+
+#ifdef BINARY
+/**
+ * @brief Wait for a single byte from the server.
+ * @param out        Receives the byte
+ * @param timeoutMs  Give up after this many milliseconds
+ * @return true if a byte arrived in time
+ */
+static bool readByte(uint8_t* out, unsigned long timeoutMs)
+{
+    unsigned long start = millis();
+    while (!client.available()) {
+        if ((millis() - start) > timeoutMs) {
+            return false;
+        }
+        yield();
+    }
+    *out = (uint8_t)client.read();
+    return true;
+}
+
+/**
+ * @brief Ask the server to switch this connection to binary frames.
+ * @return true if the server confirmed protocol version 1
+ */
+bool negotiateBinary()
+{
+    uint8_t version = 0;
+    client.write(PROTO_BINARY_HELLO);
+    if (!readByte(&version, 5000) || version != PROTO_BINARY_HELLO) {
+        Serial.println(F("Binary protocol not supported by server."));
+        return false;
+    }
+    Serial.println(F("Binary protocol v1 negotiated."));
+    return true;
+}
+
+/**
+ * @brief Send one frame: [type][varint length][payload].
+ * @param type     Frame type
+ * @param payload  Payload bytes (may be null if len is 0)
+ * @param len      Payload length
+ * @return true if everything was written
+ */
+bool sendFrame(uint8_t type, const uint8_t* payload, size_t len)
+{
+    uint8_t header[6];
+    size_t headerLen = 0;
+    header[headerLen++] = type;
+    size_t rest = len;
+    do {
+        uint8_t byte = rest & 0x7F;
+        rest >>= 7;
+        if (rest) {
+            byte |= 0x80;
+        }
+        header[headerLen++] = byte;
+    } while (rest);
+
+    if (client.write(header, headerLen) != headerLen) {
+        return false;
+    }
+    return len == 0 || client.write(payload, len) == len;
+}
+
+/**
+ * @brief Read one frame of the expected type with a 5s inactivity timeout.
+ * @param expectedType  Frame type the caller is waiting for
+ * @param payload       Destination buffer
+ * @param capacity      Size of the destination buffer
+ * @param len           Receives the payload length
+ * @return true if a frame of the expected type fit into the buffer
+ */
+bool readFrame(uint8_t expectedType, uint8_t* payload, size_t capacity, size_t* len)
+{
+    uint8_t type = 0;
+    uint8_t byte = 0;
+    if (!readByte(&type, 5000)) {
+        Serial.println(F("Frame: timeout."));
+        return false;
+    }
+    // Decode the LEB128 payload length
+    size_t length = 0;
+    unsigned shift = 0;
+    do {
+        if (shift > 28 || !readByte(&byte, 5000)) {
+            Serial.println(F("Frame: invalid length."));
+            return false;
+        }
+        length |= (size_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    if (type != expectedType || length > capacity) {
+        Serial.printf("Frame: unexpected type %u or length %u\n", type, (unsigned)length);
+        return false;
+    }
+    size_t got = 0;
+    unsigned long start = millis();
+    while (got < length) {
+        int n = client.read(payload + got, length - got);
+        if (n > 0) {
+            got += n;
+            start = millis(); // Reset timeout
+        } else if ((millis() - start) > 5000) {
+            Serial.println(F("Frame: payload timeout."));
+            return false;
+        }
+        yield();
+    }
+    *len = length;
+    return true;
+}
+#endif // BINARY
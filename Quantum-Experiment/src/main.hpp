@@ -20,6 +20,16 @@ size_t tcp_stamp = 0;
 static const int SIG_VALID = 0;
 static const int SIG_INVALID = -1;
 
+// Binary wire protocol (see PostQuantumServer/Protocol.hpp)
+static const uint8_t PROTO_BINARY_HELLO = 0xB1; // magic 0xB0 | version 1
+static const uint8_t FRAME_KEM_REQUEST = 0x01;
+static const uint8_t FRAME_KEM_INIT = 0x02;
+static const uint8_t FRAME_KEM_CIPHER = 0x03;
+static const uint8_t FRAME_CONFIDENTIAL_DATA = 0x04;
+static const uint8_t FRAME_AUTH_REQUEST = 0x05;
+static const uint8_t FRAME_AUTH_REPLY = 0x06;
+static const uint8_t FRAME_ACK = 0x07;
+
 // TCP connection and protocol handlers
 bool connectToServer();
 void processResponse(char* buffer, size_t bufferSize);
@@ -28,4 +38,12 @@ bool checkResponseLength(char* response, size_t expectedLength);
 bool processKem(char* message, size_t bufferSize);
 
 bool processAuthReply(char* reply);
-bool verifyAuthReply(const char* message, const char* signatureHex, const char* pkHex);
\ No newline at end of file
+bool verifyAuthReply(const char* message, const char* signatureHex, const char* pkHex);
+
+// Binary protocol helpers
+bool negotiateBinary();
+bool sendFrame(uint8_t type, const uint8_t* payload, size_t len);
+bool readFrame(uint8_t expectedType, uint8_t* payload, size_t capacity, size_t* len);
+bool processKemBinary(uint8_t* buffer, size_t capacity);
+bool processAuthReplyBinary(uint8_t* buffer, size_t capacity);
+bool verifySignature(const uint8_t* message, size_t msgLen, const uint8_t* sig, const char* pkHex);
\ No newline at end of file